@@ -0,0 +1,150 @@
+#include "mm_adaptive.h"
+#include "../loop_permutations/parallel/mm_parallel.h"
+#include "../loop_permutations/serial/mm_serial.h"
+#include "../main/parameters.h"
+#include "../tiled/parallel/mm_tiled_parallel.h"
+#include "../tiled/serial/mm_tiled_serial.h"
+#include <omp.h>
+
+// size of the serial i-k-j product timed to get the flop rate
+#define ADAPTIVE_CALIBRATION_SIZE 64
+#define ADAPTIVE_CALIBRATION_RUNS 20
+
+static double serial_rate = 0.0;
+static double region_overhead[ADAPTIVE_MAX_THREADS + 1];
+
+// best of a few runs of a cache-resident i-k-j product, in flop/s
+static double measure_serial_rate(void) {
+  const size_t n = ADAPTIVE_CALIBRATION_SIZE;
+  static double A[ADAPTIVE_CALIBRATION_SIZE * ADAPTIVE_CALIBRATION_SIZE];
+  static double B[ADAPTIVE_CALIBRATION_SIZE * ADAPTIVE_CALIBRATION_SIZE];
+  static double C[ADAPTIVE_CALIBRATION_SIZE * ADAPTIVE_CALIBRATION_SIZE];
+  for (size_t i = 0; i < n * n; i++) {
+    A[i] = 1.0 + (double)(i % 7);
+    B[i] = 1.0 - (double)(i % 5);
+  }
+
+  double best = 0.0;
+  for (int run = 0; run < ADAPTIVE_CALIBRATION_RUNS; run++) {
+    double start = omp_get_wtime();
+    for (size_t i = 0; i < n * n; i++) {
+      C[i] = 0.0;
+    }
+    for (size_t i = 0; i < n; i++) {
+      for (size_t k = 0; k < n; k++) {
+        const double temp = A[i * n + k];
+        for (size_t j = 0; j < n; j++) {
+          C[i * n + j] += temp * B[k * n + j];
+        }
+      }
+    }
+    double elapsed = omp_get_wtime() - start;
+    best = (run == 0 || elapsed < best) ? elapsed : best;
+  }
+  return 2.0 * (double)(n * n * n) / best;
+}
+
+// average cost of forking a team of the given size, running one worksharing
+// barrier and joining, after a warm-up region
+static double measure_region_overhead(int threads) {
+  double sink = 0.0;
+#pragma omp parallel num_threads(threads), default(none), shared(sink)
+  {
+#pragma omp atomic
+    sink += 1.0;
+  }
+
+  double start = omp_get_wtime();
+  for (int run = 0; run < ADAPTIVE_CALIBRATION_RUNS; run++) {
+#pragma omp parallel num_threads(threads), default(none), shared(sink, threads)
+    {
+#pragma omp for schedule(static)
+      for (int i = 0; i < threads; i++) {
+#pragma omp atomic
+        sink += 1.0;
+      }
+    }
+  }
+  return (omp_get_wtime() - start) / ADAPTIVE_CALIBRATION_RUNS;
+}
+
+static double predicted_time(double flops, int threads, int procs) {
+  if (threads == 1) {
+    return flops / serial_rate;
+  }
+  int busy = (threads < procs) ? threads : procs;
+  return flops / (serial_rate * busy) + region_overhead[threads];
+}
+
+int adaptive_thread_count(double flops, int thread_count) {
+  if (thread_count > ADAPTIVE_MAX_THREADS) {
+    thread_count = ADAPTIVE_MAX_THREADS;
+  }
+  if (thread_count <= 1) {
+    return 1;
+  }
+  const int procs = omp_get_num_procs();
+
+  // candidates: powers of two below the requested team and the team itself
+  int candidates[32];
+  int count = 0;
+  for (int t = 2; t < thread_count && count < 31; t *= 2) {
+    candidates[count++] = t;
+  }
+  candidates[count++] = thread_count;
+
+#pragma omp critical(adaptive_calibration)
+  {
+    if (serial_rate == 0.0) {
+      serial_rate = measure_serial_rate();
+    }
+    for (int c = 0; c < count; c++) {
+      if (region_overhead[candidates[c]] == 0.0) {
+        region_overhead[candidates[c]] = measure_region_overhead(candidates[c]);
+      }
+    }
+  }
+
+  int best = 1;
+  double best_time = predicted_time(flops, 1, procs);
+  for (int c = 0; c < count; c++) {
+    double time = predicted_time(flops, candidates[c], procs);
+    if (time < best_time) {
+      best = candidates[c];
+      best_time = time;
+    }
+  }
+  return best;
+}
+
+double adaptive_multiply_ikj(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c, int thread_count,
+                             int chunk) {
+  const double n = (double)a->size;
+  int threads = adaptive_thread_count(2.0 * n * n * n, thread_count);
+
+#ifdef DEBUG
+  printf("Adaptive - ikj - matrix size: %d - %d of %d threads\n", a->size,
+         threads, thread_count);
+#endif
+
+  if (threads == 1) {
+    return serial_multiply_ikj(a, b, c);
+  }
+  return parallel_multiply_ikj(a, b, c, threads, chunk);
+}
+
+double adaptive_multiply_tiled(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                               int thread_count, int block_size) {
+  const double n = (double)a->size;
+  int threads = adaptive_thread_count(2.0 * n * n * n, thread_count);
+
+#ifdef DEBUG
+  printf("Adaptive - tiled - matrix size: %d - %d of %d threads\n", a->size,
+         threads, thread_count);
+#endif
+
+  if (threads == 1) {
+    return serial_multiply_tiled(a, b, c, block_size);
+  }
+  return parallel_multiply_tiled(a, b, c, threads, block_size);
+}
@@ -0,0 +1,27 @@
+// ABOUTME: Adaptive front end that picks serial, fewer threads or the full team per call
+// ABOUTME: Uses a per-host calibration of the serial flop rate and the OpenMP region overhead
+
+#ifndef MM_ADAPTIVE_H
+#define MM_ADAPTIVE_H
+
+#include "../matrix/matrix.h"
+
+// team sizes above this are clamped
+#define ADAPTIVE_MAX_THREADS 256
+
+// number of threads (1 = serial, no parallel region) that minimizes the
+// predicted time of a product with the given flop count:
+//   t(1) = flops / rate,  t(p) = flops / (rate * min(p, procs)) + overhead(p)
+// The serial rate and the fork/join + barrier overhead of each team size are
+// measured once on the host, the first time they are needed
+int adaptive_thread_count(double flops, int thread_count);
+
+// serial_multiply_ikj or parallel_multiply_ikj with the adaptive thread count
+double adaptive_multiply_ikj(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c, int thread_count,
+                             int chunk);
+
+// serial_multiply_tiled or parallel_multiply_tiled with the adaptive thread count
+double adaptive_multiply_tiled(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                               int thread_count, int block_size);
+
+#endif // MM_ADAPTIVE_H
@@ -0,0 +1,68 @@
+#include "mm_batched.h"
+#include "../loop_permutations/serial/mm_serial_fixed.h"
+
+// i-k-j; each row of C is cleared right before it is accumulated, so there is
+// no separate zeroing pass
+static void batch_kernel_generic(size_t m, size_t n, size_t k,
+                                 const double *restrict A, size_t lda,
+                                 const double *restrict B, size_t ldb,
+                                 double *restrict C, size_t ldc) {
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      C[i * ldc + j] = 0.0;
+    }
+    for (size_t p = 0; p < k; p++) {
+      const double temp = A[i * lda + p];
+      for (size_t j = 0; j < n; j++) {
+        C[i * ldc + j] += temp * B[p * ldb + j];
+      }
+    }
+  }
+}
+
+// the fixed-size i-k-j kernel of the serial loops when m == n == k is one of
+// the MM_FIXED_SIZES, otherwise NULL for the generic kernel
+static fixed_kernel select_kernel(size_t m, size_t n, size_t k) {
+  return (m == n && n == k) ? serial_fixed_kernel(n) : NULL;
+}
+
+void gemm_batched(size_t m, size_t n, size_t k, const double *const *A,
+                  size_t lda, const double *const *B, size_t ldb,
+                  double *const *C, size_t ldc, size_t batch_count,
+                  int thread_count) {
+  const fixed_kernel kernel = select_kernel(m, n, k);
+  size_t item;
+
+#pragma omp parallel for num_threads(thread_count), default(none),             \
+    private(item), shared(kernel, m, n, k, A, lda, B, ldb, C, ldc,             \
+                          batch_count) schedule(static)
+  for (item = 0; item < batch_count; item++) {
+    if (kernel != NULL) {
+      kernel(A[item], lda, B[item], ldb, C[item], ldc);
+    } else {
+      batch_kernel_generic(m, n, k, A[item], lda, B[item], ldb, C[item], ldc);
+    }
+  }
+}
+
+void gemm_batched_strided(size_t m, size_t n, size_t k, const double *A,
+                          size_t lda, size_t stride_a, const double *B,
+                          size_t ldb, size_t stride_b, double *C, size_t ldc,
+                          size_t stride_c, size_t batch_count,
+                          int thread_count) {
+  const fixed_kernel kernel = select_kernel(m, n, k);
+  size_t item;
+
+#pragma omp parallel for num_threads(thread_count), default(none),             \
+    private(item), shared(kernel, m, n, k, A, lda, stride_a, B, ldb, stride_b, \
+                          C, ldc, stride_c, batch_count) schedule(static)
+  for (item = 0; item < batch_count; item++) {
+    if (kernel != NULL) {
+      kernel(&A[item * stride_a], lda, &B[item * stride_b], ldb,
+             &C[item * stride_c], ldc);
+    } else {
+      batch_kernel_generic(m, n, k, &A[item * stride_a], lda,
+                           &B[item * stride_b], ldb, &C[item * stride_c], ldc);
+    }
+  }
+}
@@ -0,0 +1,26 @@
+// ABOUTME: Batched small-matrix multiplication parallelized across the batch
+// ABOUTME: One OpenMP region per batch, the fixed-size serial kernels for the MM_FIXED_SIZES
+
+#ifndef MM_BATCHED_H
+#define MM_BATCHED_H
+
+#include <stddef.h>
+
+// C[b] (m x n) = A[b] (m x k) * B[b] (k x n) for every b < batch_count, all
+// operands row-major with shared leading dimensions; C is overwritten, not
+// accumulated into, so it needs no clearing. Items are distributed over one
+// team of threads; each item runs serially, with the unrolled kernel of
+// mm_serial_fixed.h when m == n == k is one of the MM_FIXED_SIZES
+void gemm_batched(size_t m, size_t n, size_t k, const double *const *A,
+                  size_t lda, const double *const *B, size_t ldb,
+                  double *const *C, size_t ldc, size_t batch_count,
+                  int thread_count);
+
+// same, with item b of each operand at X + b * stride_x
+void gemm_batched_strided(size_t m, size_t n, size_t k, const double *A,
+                          size_t lda, size_t stride_a, const double *B,
+                          size_t ldb, size_t stride_b, double *C, size_t ldc,
+                          size_t stride_c, size_t batch_count,
+                          int thread_count);
+
+#endif // MM_BATCHED_H
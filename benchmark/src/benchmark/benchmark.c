@@ -1,20 +1,238 @@
 #include "benchmark.h"
+#include "../adaptive/mm_adaptive.h"
+#include "../batched/mm_batched.h"
 #include "../loop_permutations/parallel/mm_parallel.h"
 #include "../loop_permutations/serial/mm_serial.h"
 #include "../main/parameters.h"
+#include "../perf/perf_counters.h"
+#include "../recursive/mm_recursive.h"
+#include "../roofline/roofline.h"
+#include "../strassen/mm_strassen.h"
 #include "../tiled/parallel/mm_tiled_parallel.h"
 #include "../tiled/serial/mm_tiled_serial.h"
+#include "../utils/utils.h"
+#include <limits.h>
+#include <math.h>
+#include <omp.h>
+
+static ValidationMode validation_mode = VALIDATE_REFERENCE;
+static int validation_trials = FREIVALDS_TRIALS;
+
+void set_validation_mode(ValidationMode mode, int freivalds_trials) {
+  validation_mode = mode;
+  validation_trials = freivalds_trials;
+}
+
+static const char *const permutation_names[LOOP_PERMUTATIONS] = {"IJK", "IKJ", "JIK", "JKI", "KIJ", "KJI"};
+
+static TimingPolicy timing_policy = {WARMUP_RUNS, REPETITIONS, MAX_REPETITIONS, TARGET_CI};
+
+void set_timing_policy(const TimingPolicy *policy) {
+  timing_policy = *policy;
+}
+
+static int kernel_counters = 0;
+static int roofline_recorded[ROOFLINE_MAX_THREADS + 1];
+
+// the roofline of a team size, appended to roofline.csv the first time it is
+// used in this run
+static const Roofline *machine_roofline(int thread_count) {
+  const Roofline *roofline = roofline_machine(thread_count);
+  if (!roofline_recorded[roofline->thread_count]) {
+    roofline_recorded[roofline->thread_count] = 1;
+    FILE *csv_file = open_csv_file(csv_roofline);
+    fprintf(csv_file, "%d,%.3f,%.3f,%s\n", roofline->thread_count, roofline->peak_gflops, roofline->bandwidth_gbs,
+            roofline->peak_kernel);
+    fclose(csv_file);
+  }
+  return roofline;
+}
+
+void set_kernel_metrics(int counters, int thread_count) {
+  kernel_counters = counters;
+  if (counters && perf_counters_open(thread_count) == 0) {
+    printf("Warning: hardware performance counters are unavailable, %s gets the times only\n",
+           csv_kernel_metrics.filename);
+  }
+  // probed before any kernel runs, so that no kernel pays for it
+  machine_roofline(1);
+  machine_roofline(thread_count);
+}
+
+// the measured runs between metrics_begin and metrics_end become one row of
+// kernel_metrics.csv, with the counters averaged over the runs; unavailable
+// counters are left empty
+static void metrics_begin(void) {
+  if (kernel_counters) {
+    perf_counters_start();
+  }
+}
+
+static void metrics_end(const char *benchmark, const char *kernel, int matrix_size, int thread_count, int parameter,
+                        const TimingStats *stats) {
+  PerfSample sample;
+  if (kernel_counters) {
+    perf_counters_stop(&sample);
+  } else {
+    for (int m = 0; m < PERF_METRICS; m++) {
+      sample.values[m] = NAN;
+    }
+  }
+
+  // nominal 2 n^3 flops for every kernel, so Strassen and the sparse kernels
+  // report an effective rate
+  const Roofline *roofline = machine_roofline(thread_count);
+  const size_t n = (size_t)matrix_size;
+  const double flops = gemm_flops(n, n, n);
+  const double gflops = flops / stats->median * 1e-9;
+  const double intensity = gemm_intensity(n, n, n);
+  const double attainable = roofline_attainable(roofline, intensity);
+
+  FILE *csv_file = open_csv_file(csv_kernel_metrics);
+  fprintf(csv_file, "%s,%s,%d,%d,%d,%.9f,%d,%d,%.9f,%.9f,%.9f,%.9f", benchmark, kernel, matrix_size, thread_count,
+          parameter, stats->median, stats->runs, stats->outliers, stats->min, stats->mean, stats->stddev,
+          isinf(stats->ci95) ? 0.0 : stats->ci95);
+  for (int m = 0; m < PERF_METRICS; m++) {
+    sample.values[m] /= stats->runs;
+    if (isnan(sample.values[m])) {
+      fprintf(csv_file, ",");
+    } else {
+      fprintf(csv_file, ",%.0f", sample.values[m]);
+    }
+  }
+  fprintf(csv_file, ",%.3f,%.3f", gflops, intensity);
+  // memory traffic seen by the counters: one cache line per last level miss
+  if (isnan(sample.values[PERF_LLC_MISSES]) || sample.values[PERF_LLC_MISSES] <= 0.0) {
+    fprintf(csv_file, ",");
+  } else {
+    fprintf(csv_file, ",%.3f", flops / (sample.values[PERF_LLC_MISSES] * ROOFLINE_LINE_BYTES));
+  }
+  fprintf(csv_file, ",%.3f,%.2f\n", attainable, 100.0 * gflops / attainable);
+  fclose(csv_file);
+}
+
+// warmup and measured runs of call; the measured runs become one row of
+// kernel_metrics.csv and their median is stored to result
+#define MEASURE_KERNEL(result, benchmark, kernel, matrix_size, thread_count, parameter, call)                         \
+  do {                                                                                                                \
+    TimingStats stats_;                                                                                               \
+    TIMING_WARMUP(&timing_policy, call);                                                                              \
+    metrics_begin();                                                                                                  \
+    TIMING_REPEAT(&timing_policy, &stats_, call);                                                                     \
+    metrics_end(benchmark, kernel, matrix_size, thread_count, parameter, &stats_);                                    \
+    (result) = stats_.median;                                                                                         \
+  } while (0)
+
+static const char *reference_directory = NULL;
+
+void set_reference_cache_directory(const char *directory) {
+  reference_directory = directory;
+}
+
+void reference_cache_init(ReferenceCache *cache, const char *name, serial_loop_benchmark kernel) {
+  cache->name = name;
+  cache->kernel = kernel;
+  cache->size = -1;
+  cache->time = 0.0;
+  cache->cached = 0;
+}
+
+void reference_cache_clear(ReferenceCache *cache) {
+  if (cache->size >= 0) {
+    matrix_destroy(&cache->product);
+  }
+  cache->size = -1;
+}
+
+// reads a reference written by store_reference; 0 when there is none
+static int load_reference(ReferenceCache *cache, const char *path, int size) {
+  char time_path[PATH_MAX + sizeof(".time")];
+  snprintf(time_path, sizeof(time_path), "%s.time", path);
+  FILE *time_file = fopen(time_path, "r");
+  if (time_file == NULL) {
+    return 0;
+  }
+  int found = fscanf(time_file, "%lf", &cache->time) == 1;
+  fclose(time_file);
+  if (!found) {
+    return 0;
+  }
+
+  matrix_load(&cache->product, path);
+  if (cache->product.size != size) {
+    printf("Error: %s holds a matrix of size %d, expected %d\n", path, cache->product.size, size);
+    exit(1);
+  }
+  return 1;
+}
+
+static void store_reference(const ReferenceCache *cache, const char *path) {
+  ensure_directory_exists(reference_directory);
+  matrix_store(&cache->product, path);
+
+  // the time file goes last: its presence marks a complete entry
+  char time_path[PATH_MAX + sizeof(".time")];
+  snprintf(time_path, sizeof(time_path), "%s.time", path);
+  FILE *time_file = fopen(time_path, "w");
+  if (time_file == NULL) {
+    printf("Error opening file %s\n", time_path);
+    exit(1);
+  }
+  fprintf(time_file, "%.17g\n", cache->time);
+  fclose(time_file);
+}
+
+const Matrix *reference_cache_get(ReferenceCache *cache, const Matrix *restrict a, const Matrix *restrict b,
+                                  double *time) {
+  if (cache->size == a->size) {
+    *time = cache->time;
+    return &cache->product;
+  }
+  reference_cache_clear(cache);
+
+  char path[PATH_MAX];
+  if (reference_directory != NULL) {
+    snprintf(path, sizeof(path), "%s/%s_n%d_seed%llu_f64.mat", reference_directory, cache->name, a->size,
+             (unsigned long long)matrix_random_seed());
+  }
+
+  cache->cached = reference_directory != NULL && load_reference(cache, path, a->size);
+  if (cache->cached) {
+#ifdef DEBUG
+    printf("Reference %s - matrix size: %d - read from %s\n", cache->name, a->size, path);
+#endif
+  } else {
+    matrix_create(&cache->product, a->size);
+    MEASURE_KERNEL(cache->time, "reference", cache->name, a->size, 1, 0, cache->kernel(a, b, &cache->product));
+    if (reference_directory != NULL) {
+      store_reference(cache, path);
+    }
+  }
+
+  cache->size = a->size;
+  *time = cache->time;
+  return &cache->product;
+}
+
+// checks c == a * b with the selected mode; reference is the baseline product
+static int check_product(const Matrix *restrict a, const Matrix *restrict b, const Matrix *restrict reference,
+                         const Matrix *restrict c) {
+  if (validation_mode == VALIDATE_FREIVALDS) {
+    return freivalds_validate(a, b, c, validation_trials);
+  }
+  return validate(reference, c);
+}
 
 int run_serial_loop_permutation(double time_results[], const Matrix *restrict a, const Matrix *restrict b,
                                 const Matrix *restrict reference, int permutation) {
 
   Matrix c;
   matrix_create(&c, a->size);
-  time_results[permutation] =
-      serial_loop_benchmark_functions[permutation](a, b, &c);
+  MEASURE_KERNEL(time_results[permutation], "serial_permutations", permutation_names[permutation], a->size, 1, 0,
+                 serial_loop_benchmark_functions[permutation](a, b, &c));
   int result = 1;
 #ifdef DEBUG
-  result = validate(reference, &c);
+  result = check_product(a, b, reference, &c);
   if (result) {
     printf(GREEN "Permutation %d is correct" RESET "\n", permutation);
   } else {
@@ -28,7 +246,8 @@ int run_serial_loop_permutation(double time_results[], const Matrix *restrict a,
   return result;
 }
 
-void test_serial_loop_permutations(double time_results[], const Matrix *restrict a, const Matrix *restrict b) {
+void test_serial_loop_permutations(double time_results[], ReferenceCache *reference_ijk, const Matrix *restrict a,
+                                   const Matrix *restrict b) {
 
 #ifdef DEBUG
   printf("Serial - Testing loop permutations - matrix size: %d\n", a->size);
@@ -36,19 +255,15 @@ void test_serial_loop_permutations(double time_results[], const Matrix *restrict
          "---------------------------------------------------\n");
 #endif
 
-  Matrix reference;
-  matrix_create(&reference, a->size);
-  time_results[0] = serial_loop_benchmark_functions[0](a, b, &reference);
+  const Matrix *reference = reference_cache_get(reference_ijk, a, b, &time_results[0]);
 
   int correct_count = 0;
   for (int i = 1; i < LOOP_PERMUTATIONS; i++) {
-    if (run_serial_loop_permutation(time_results, a, b, &reference, i)) {
+    if (run_serial_loop_permutation(time_results, a, b, reference, i)) {
       correct_count++;
     }
   }
 
-  matrix_destroy(&reference);
-
 #ifdef DEBUG
   printf("Serial - Test completed - matrix size: %d\n", a->size);
   printf("Correct count: %d\n", correct_count);
@@ -64,11 +279,11 @@ int run_parallel_loop_permutation(double time_results[], const Matrix *restrict
 
   Matrix c;
   matrix_create(&c, a->size);
-  time_results[permutation] = parallel_loop_benchmark_functions[permutation](
-      a, b, &c, thread_count, chunk);
+  MEASURE_KERNEL(time_results[permutation], "parallel_permutations", permutation_names[permutation], a->size,
+                 thread_count, chunk, parallel_loop_benchmark_functions[permutation](a, b, &c, thread_count, chunk));
   int result = 1;
 #ifdef DEBUG
-  result = validate(reference, &c);
+  result = check_product(a, b, reference, &c);
   if (result) {
     printf(GREEN "Permutation %d is correct" RESET "\n", permutation);
   } else {
@@ -96,8 +311,8 @@ void test_parallel_loop_permutations(double time_results[], const Matrix *restri
   // set the IJK permutation as reference
   Matrix reference;
   matrix_create(&reference, a->size);
-  time_results[0] = parallel_loop_benchmark_functions[0](
-      a, b, &reference, thread_count, chunk_size);
+  MEASURE_KERNEL(time_results[0], "parallel_permutations", permutation_names[0], a->size, thread_count, chunk_size,
+                 parallel_loop_benchmark_functions[0](a, b, &reference, thread_count, chunk_size));
 
   int correct_count = 0;
   for (int i = 1; i < LOOP_PERMUTATIONS; i++) {
@@ -120,15 +335,18 @@ void test_parallel_loop_permutations(double time_results[], const Matrix *restri
 #endif
 }
 
-void test_serial_parallel_scaling_classic(double time_results[], const Matrix *restrict a,
-                                         const Matrix *restrict b, int chunk) {
+void test_serial_parallel_scaling_classic(double time_results[], ReferenceCache *reference_ijk,
+                                          const Matrix *restrict a, const Matrix *restrict b, int chunk) {
 
   Matrix c;
   matrix_create(&c, a->size);
-  time_results[0] = serial_multiply_ijk(a, b, &c);
-  time_results[1] = parallel_multiply_ijk(a, b, &c, 2, chunk);
-  time_results[2] = parallel_multiply_ijk(a, b, &c, 4, chunk);
-  time_results[3] = parallel_multiply_ijk(a, b, &c, 8, chunk);
+  reference_cache_get(reference_ijk, a, b, &time_results[0]);
+  MEASURE_KERNEL(time_results[1], "serial_parallel_scaling_classic", "P2T", a->size, 2, chunk,
+                 parallel_multiply_ijk(a, b, &c, 2, chunk));
+  MEASURE_KERNEL(time_results[2], "serial_parallel_scaling_classic", "P4T", a->size, 4, chunk,
+                 parallel_multiply_ijk(a, b, &c, 4, chunk));
+  MEASURE_KERNEL(time_results[3], "serial_parallel_scaling_classic", "P8T", a->size, 8, chunk,
+                 parallel_multiply_ijk(a, b, &c, 8, chunk));
   matrix_destroy(&c);
 
 #ifdef DEBUG
@@ -139,14 +357,17 @@ void test_serial_parallel_scaling_classic(double time_results[], const Matrix *r
 #endif
 }
 
-void test_serial_parallel_scaling_improved(double time_results[], const Matrix *restrict a,
-                                          const Matrix *restrict b, int chunk) {
+void test_serial_parallel_scaling_improved(double time_results[], ReferenceCache *reference_ikj,
+                                           const Matrix *restrict a, const Matrix *restrict b, int chunk) {
   Matrix c;
   matrix_create(&c, a->size);
-  time_results[0] = serial_multiply_ikj(a, b, &c);
-  time_results[1] = parallel_multiply_ikj(a, b, &c, 2, chunk);
-  time_results[2] = parallel_multiply_ikj(a, b, &c, 4, chunk);
-  time_results[3] = parallel_multiply_ikj(a, b, &c, 8, chunk);
+  reference_cache_get(reference_ikj, a, b, &time_results[0]);
+  MEASURE_KERNEL(time_results[1], "serial_parallel_scaling_improved", "P2T", a->size, 2, chunk,
+                 parallel_multiply_ikj(a, b, &c, 2, chunk));
+  MEASURE_KERNEL(time_results[2], "serial_parallel_scaling_improved", "P4T", a->size, 4, chunk,
+                 parallel_multiply_ikj(a, b, &c, 4, chunk));
+  MEASURE_KERNEL(time_results[3], "serial_parallel_scaling_improved", "P8T", a->size, 8, chunk,
+                 parallel_multiply_ikj(a, b, &c, 8, chunk));
   matrix_destroy(&c);
 
 #ifdef DEBUG
@@ -157,14 +378,75 @@ void test_serial_parallel_scaling_improved(double time_results[], const Matrix *
 #endif
 }
 
-void test_tiled(double time_results[], const Matrix *restrict a, const Matrix *restrict b, int thread_count,
-               int block_size) {
-  Matrix reference, c;
-  matrix_create(&reference, a->size);
+static void check_tiled_result(const char *label, const Matrix *restrict a, const Matrix *restrict b,
+                               const Matrix *restrict reference, const Matrix *restrict c, int thread_count,
+                               int block_size, double time) {
+#ifdef DEBUG_MATRIX
+  matrix_print(c);
+#endif
+
+#ifdef DEBUG
+  if (check_product(a, b, reference, c)) {
+    printf(GREEN "%s - matrix size: %d, threads: %d, block size: %d - "
+                 "completed - time: %f" RESET "\n",
+           label, c->size, thread_count, block_size, time);
+  } else {
+    printf(RED "INCORRECT - %s - matrix size: %d, threads: %d, block "
+               "size: %d" RESET "\n",
+           label, c->size, thread_count, block_size);
+  }
+#else
+  (void)label;
+  (void)a;
+  (void)b;
+  (void)reference;
+  (void)c;
+  (void)thread_count;
+  (void)block_size;
+  (void)time;
+#endif
+}
+
+// converts the operands to the Z-order layout, runs the kernel and converts C
+// back; the conversions are timed apart from the kernel
+static double run_morton_kernel(morton_benchmark kernel, const char *name, const Matrix *restrict a,
+                                const Matrix *restrict b, Matrix *restrict c, int thread_count, int block_size,
+                                size_t tile, double *convert_time) {
+  MortonMatrix za, zb, zc;
+  morton_create(&za, a->size, tile);
+  morton_create(&zb, b->size, tile);
+  morton_create(&zc, c->size, tile);
+
+  double start = omp_get_wtime();
+  matrix_to_morton(a, &za);
+  matrix_to_morton(b, &zb);
+  *convert_time = omp_get_wtime() - start;
+
+  double time;
+  MEASURE_KERNEL(time, "tiled", name, a->size, thread_count, block_size, kernel(&za, &zb, &zc, thread_count));
+
+  start = omp_get_wtime();
+  morton_to_matrix(&zc, c);
+  *convert_time += omp_get_wtime() - start;
+
+  morton_destroy(&za);
+  morton_destroy(&zb);
+  morton_destroy(&zc);
+  return time;
+}
+
+void test_tiled(double time_results[], TiledReport *report, ReferenceCache *reference_ikj, const Matrix *restrict a,
+                const Matrix *restrict b, int thread_count, int block_size) {
+  Matrix c;
   matrix_create(&c, a->size);
 
-  time_results[0] = serial_multiply_ikj(a, b, &reference);
-  time_results[1] = parallel_multiply_ikj(a, b, &c, thread_count, block_size);
+  // the row-parallel baseline uses the block size as its chunk size
+  GemmBlocking blocking;
+  gemm_blocking_select(block_size, &blocking);
+
+  const Matrix *reference = reference_cache_get(reference_ikj, a, b, &time_results[0]);
+  MEASURE_KERNEL(time_results[1], "tiled", "PARALLEL_IKJ", a->size, thread_count, block_size,
+                 parallel_multiply_ikj(a, b, &c, thread_count, (int)blocking.mc));
 
 #ifdef DEBUG_MATRIX
   matrix_print(&c);
@@ -175,69 +457,209 @@ void test_tiled(double time_results[], const Matrix *restrict a, const Matrix *r
          "---------------------------------------------------\n");
 #endif
 
-  time_results[2] = serial_multiply_tiled(a, b, &c, block_size);
+  MEASURE_KERNEL(time_results[2], "tiled", "SERIAL_TILED", a->size, 1, block_size,
+                 serial_multiply_tiled(a, b, &c, block_size));
+  check_tiled_result("Serial - tiled", a, b, reference, &c, 1, block_size, time_results[2]);
+
+  MEASURE_KERNEL(time_results[3], "tiled", "PARALLEL_TILED", a->size, thread_count, block_size,
+                 parallel_multiply_tiled(a, b, &c, thread_count, block_size));
+  check_tiled_result("Parallel - tiled", a, b, reference, &c, thread_count, block_size, time_results[3]);
+
+  MEASURE_KERNEL(time_results[4], "tiled", "PARALLEL_TILED_TASKS", a->size, thread_count, block_size,
+                 parallel_multiply_tiled_tasks(a, b, &c, thread_count, block_size));
+  check_tiled_result("Parallel - tiled tasks", a, b, reference, &c, thread_count, block_size, time_results[4]);
+
+  MEASURE_KERNEL(time_results[5], "tiled", "SERIAL_TILED_PACKED", a->size, 1, block_size,
+                 serial_multiply_tiled_packed(a, b, &c, block_size));
+  check_tiled_result("Serial - tiled packed", a, b, reference, &c, 1, block_size, time_results[5]);
+
+  MEASURE_KERNEL(time_results[6], "tiled", "PARALLEL_TILED_PACKED", a->size, thread_count, block_size,
+                 parallel_multiply_tiled_packed(a, b, &c, thread_count, block_size));
+  check_tiled_result("Parallel - tiled packed", a, b, reference, &c, thread_count, block_size, time_results[6]);
+
+  MEASURE_KERNEL(time_results[7], "tiled", "PARALLEL_TILED_KSPLIT", a->size, thread_count, block_size,
+                 parallel_multiply_tiled_ksplit(a, b, &c, thread_count, block_size));
+  check_tiled_result("Parallel - tiled k-split", a, b, reference, &c, thread_count, block_size, time_results[7]);
+
+  // Strassen trades accuracy for fewer multiplications, so its error is
+  // reported instead of only being checked against EPSILON
+  size_t strassen_bytes = 0;
+  MEASURE_KERNEL(time_results[8], "tiled", "STRASSEN", a->size, thread_count, block_size,
+                 parallel_multiply_strassen(a, b, &c, thread_count, STRASSEN_CUTOFF_AUTO, &strassen_bytes));
+  check_tiled_result("Parallel - Strassen-Winograd", a, b, reference, &c, thread_count, block_size, time_results[8]);
+  report->strassen_mem_mb = (double)strassen_bytes / (1024.0 * 1024.0);
+  report->strassen_max_error = matrix_max_error(reference, &c);
+
+  // cache-oblivious: ignores the block size
+  MEASURE_KERNEL(time_results[9], "tiled", "PARALLEL_RECURSIVE", a->size, thread_count, block_size,
+                 parallel_multiply_recursive(a, b, &c, thread_count));
+  check_tiled_result("Parallel - recursive", a, b, reference, &c, thread_count, block_size, time_results[9]);
+
+  size_t morton_tile = (block_size == BLOCK_SIZE_AUTO) ? host_square_tile() : (size_t)block_size;
+  time_results[10] = run_morton_kernel(parallel_multiply_tiled_morton, "PARALLEL_TILED_MORTON", a, b, &c,
+                                       thread_count, block_size, morton_tile, &report->tiled_morton_convert_time);
+  check_tiled_result("Parallel - tiled Z-order", a, b, reference, &c, thread_count, block_size, time_results[10]);
+
+  time_results[11] = run_morton_kernel(parallel_multiply_recursive_morton, "PARALLEL_RECURSIVE_MORTON", a, b,
+                                       &c, thread_count, block_size, RECURSIVE_LEAF,
+                                       &report->recursive_morton_convert_time);
+  check_tiled_result("Parallel - recursive Z-order", a, b, reference, &c, thread_count, block_size, time_results[11]);
+
+  MEASURE_KERNEL(time_results[12], "tiled", "ADAPTIVE_TILED", a->size, thread_count, block_size,
+                 adaptive_multiply_tiled(a, b, &c, thread_count, block_size));
+  check_tiled_result("Adaptive - tiled", a, b, reference, &c, thread_count, block_size, time_results[12]);
 
-#ifdef DEBUG_MATRIX
-  matrix_print(&c);
+#ifdef DEBUG
+  printf("---------------------------------------------------------------------"
+         "---------------------------------------------------\n");
 #endif
 
+  matrix_destroy(&c);
+}
+
+void test_sparse(double time_results[], size_t skipped_results[], const Matrix *restrict a,
+                 const Matrix *restrict b, int thread_count, int block_size) {
+  Matrix reference, c;
+  matrix_create(&reference, a->size);
+  matrix_create(&c, a->size);
+
+  MEASURE_KERNEL(time_results[0], "sparse", "SERIAL_TILED", a->size, 1, block_size,
+                 serial_multiply_tiled(a, b, &reference, block_size));
+  MEASURE_KERNEL(time_results[1], "sparse", "PARALLEL_TILED", a->size, thread_count, block_size,
+                 parallel_multiply_tiled(a, b, &c, thread_count, block_size));
+  check_tiled_result("Parallel - tiled (banded input)", a, b, &reference, &c, thread_count, block_size,
+                     time_results[1]);
+
+  MEASURE_KERNEL(time_results[2], "sparse", "SERIAL_TILED_SPARSE", a->size, 1, block_size,
+                 serial_multiply_tiled_sparse(a, b, &c, block_size, &skipped_results[0]));
+  check_tiled_result("Serial - tiled sparse", a, b, &reference, &c, 1, block_size, time_results[2]);
+
+  MEASURE_KERNEL(time_results[3], "sparse", "PARALLEL_TILED_SPARSE", a->size, thread_count, block_size,
+                 parallel_multiply_tiled_sparse(a, b, &c, thread_count, block_size, &skipped_results[1]));
+  check_tiled_result("Parallel - tiled sparse", a, b, &reference, &c, thread_count, block_size, time_results[3]);
+
 #ifdef DEBUG
-  int result = validate(&reference, &c);
-  if (result) {
-    printf(GREEN "Serial - tiled - matrix size: %d, block size: %d - "
-                 "completed - "
-                 "time: %f" RESET "\n",
-           a->size, block_size, time_results[2]);
-  } else {
-    printf(RED "INCORRECT - Serial - tiled - matrix size: %d, block "
-               "size: %d" RESET "\n",
-           a->size, block_size);
-  }
+  printf("Sparse - matrix size: %d, block size: %d - skipped tile products: serial %zu, parallel %zu\n", a->size,
+         block_size, skipped_results[0], skipped_results[1]);
+  printf("---------------------------------------------------------------------"
+         "---------------------------------------------------\n");
 #endif
 
-  time_results[3] = parallel_multiply_tiled(a, b, &c, thread_count, block_size);
+  matrix_destroy(&reference);
+  matrix_destroy(&c);
+}
 
-#ifdef DEBUG_MATRIX
-  matrix_print(&c);
-#endif
+// a loop of single products over the batch, one parallel region (or one
+// adaptive call) each
+static double batched_loop(const Matrix *a, const Matrix *b, Matrix *c, size_t batch_count, int thread_count,
+                           int adaptive) {
+  double time = 0.0;
+  for (size_t item = 0; item < batch_count; item++) {
+    time += adaptive ? adaptive_multiply_ikj(&a[item], &b[item], &c[item], thread_count, 1)
+                     : parallel_multiply_ikj(&a[item], &b[item], &c[item], thread_count, 1);
+  }
+  return time;
+}
 
-#ifdef DEBUG
-  result = validate(&reference, &c);
-  if (result) {
-    printf(GREEN "Parallel - tiled - matrix size: %d, threads: %d, block "
-                 "size: %d - completed - time: %f" RESET "\n",
-           a->size, thread_count, block_size, time_results[3]);
-  } else {
-    printf(RED "INCORRECT - Parallel - tiled - matrix size: %d, threads: "
-               "%d, block size: %d" RESET "\n",
-           a->size, thread_count, block_size);
+// the batched APIs overwrite C, so repeated runs need no clearing
+static double batched_pointers(size_t n, const double **a_items, const double **b_items, double **c_items,
+                               size_t ld, size_t batch_count, int thread_count) {
+  double start = omp_get_wtime();
+  gemm_batched(n, n, n, a_items, ld, b_items, ld, c_items, ld, batch_count, thread_count);
+  return omp_get_wtime() - start;
+}
+
+static double batched_strided(size_t n, const Matrix *a, const Matrix *b, Matrix *c, size_t ld, size_t stride,
+                              size_t batch_count, int thread_count) {
+  double start = omp_get_wtime();
+  gemm_batched_strided(n, n, n, a[0].data, ld, stride, b[0].data, ld, stride, c[0].data, ld, stride, batch_count,
+                       thread_count);
+  return omp_get_wtime() - start;
+}
+
+void test_batched(double time_results[], int matrix_size, size_t batch_count, int thread_count) {
+  Matrix *a = malloc(4 * batch_count * sizeof(Matrix));
+  const double **a_items = malloc(2 * batch_count * sizeof(double *));
+  double **c_items = malloc(batch_count * sizeof(double *));
+  if (a == NULL || a_items == NULL || c_items == NULL) {
+    printf("Error: Failed to allocate memory for batch\n");
+    exit(1);
   }
-#endif
+  Matrix *b = a + batch_count, *reference = b + batch_count, *c = reference + batch_count;
+  const double **b_items = a_items + batch_count;
+
+  const size_t stride = matrix_create_batch(a, matrix_size, batch_count);
+  matrix_create_batch(b, matrix_size, batch_count);
+  matrix_create_batch(reference, matrix_size, batch_count);
+  matrix_create_batch(c, matrix_size, batch_count);
+  for (size_t item = 0; item < batch_count; item++) {
+    matrix_fill_random(&a[item]);
+    matrix_fill_random(&b[item]);
+    a_items[item] = a[item].data;
+    b_items[item] = b[item].data;
+    c_items[item] = c[item].data;
+  }
+  const size_t n = (size_t)matrix_size, ld = a[0].ld;
 
-  time_results[4] =
-      parallel_multiply_tiled_tasks(a, b, &c, thread_count, block_size);
+  // the batch is timed as a whole, each entry the median of its runs
+  TimingStats stats;
 
-#ifdef DEBUG_MATRIX
-  matrix_print(&c);
-#endif
+  // baseline: one parallel region per product
+  TIMING_WARMUP(&timing_policy, batched_loop(a, b, reference, batch_count, thread_count, 0));
+  TIMING_REPEAT(&timing_policy, &stats, batched_loop(a, b, reference, batch_count, thread_count, 0));
+  time_results[0] = stats.median;
+
+  TIMING_WARMUP(&timing_policy, batched_pointers(n, a_items, b_items, c_items, ld, batch_count, thread_count));
+  TIMING_REPEAT(&timing_policy, &stats, batched_pointers(n, a_items, b_items, c_items, ld, batch_count, thread_count));
+  time_results[1] = stats.median;
+
+  int correct = 1;
+  for (size_t item = 0; item < batch_count; item++) {
+    correct = correct && check_product(&a[item], &b[item], &reference[item], &c[item]);
+  }
+
+  // cleared once, so the check below cannot pass on the previous products
+  for (size_t item = 0; item < batch_count; item++) {
+    matrix_fill_zero(&c[item]);
+  }
+  TIMING_WARMUP(&timing_policy, batched_strided(n, a, b, c, ld, stride, batch_count, thread_count));
+  TIMING_REPEAT(&timing_policy, &stats, batched_strided(n, a, b, c, ld, stride, batch_count, thread_count));
+  time_results[2] = stats.median;
+
+  for (size_t item = 0; item < batch_count; item++) {
+    correct = correct && check_product(&a[item], &b[item], &reference[item], &c[item]);
+  }
+
+  // same loop through the adaptive front end, which drops to fewer threads or
+  // to the serial kernel when the region overhead would dominate
+  TIMING_WARMUP(&timing_policy, batched_loop(a, b, c, batch_count, thread_count, 1));
+  TIMING_REPEAT(&timing_policy, &stats, batched_loop(a, b, c, batch_count, thread_count, 1));
+  time_results[3] = stats.median;
+  for (size_t item = 0; item < batch_count; item++) {
+    correct = correct && check_product(&a[item], &b[item], &reference[item], &c[item]);
+  }
 
 #ifdef DEBUG
-  result = validate(&reference, &c);
-  if (result) {
-    printf(GREEN "Parallel - tiled tasks - matrix size: %d, threads: %d, block "
-                 "size: %d - completed - time: %f" RESET "\n",
-           a->size, thread_count, block_size, time_results[4]);
+  if (correct) {
+    printf(GREEN "Batched - matrix size: %d, batch: %zu, threads: %d - completed - loop: %f, batched: %f, "
+                 "strided: %f, adaptive loop: %f" RESET "\n",
+           matrix_size, batch_count, thread_count, time_results[0], time_results[1], time_results[2],
+           time_results[3]);
   } else {
-    printf(RED "INCORRECT - Parallel - tiled tasks - matrix size: %d, threads: "
-               "%d, block size: %d" RESET "\n",
-           a->size, thread_count, block_size);
+    printf(RED "INCORRECT - Batched - matrix size: %d, batch: %zu, threads: %d" RESET "\n", matrix_size,
+           batch_count, thread_count);
   }
-  printf("---------------------------------------------------------------------"
-         "---------------------------------------------------\n");
+#else
+  (void)correct;
 #endif
 
-  matrix_destroy(&reference);
-  matrix_destroy(&c);
+  matrix_destroy_batch(a);
+  matrix_destroy_batch(b);
+  matrix_destroy_batch(reference);
+  matrix_destroy_batch(c);
+  free(a);
+  free(a_items);
+  free(c_items);
 }
 
 void compute_speedup(double time_results[], double speedup_results[],
@@ -246,3 +668,11 @@ void compute_speedup(double time_results[], double speedup_results[],
     speedup_results[i] = time_results[0] / time_results[i];
   }
 }
+
+void compute_gflops(double time_results[], double gflops_results[], int size,
+                    int matrix_size) {
+  const double flops = 2.0 * matrix_size * matrix_size * (double)matrix_size;
+  for (int i = 0; i < size; i++) {
+    gflops_results[i] = flops / time_results[i] * 1e-9;
+  }
+}
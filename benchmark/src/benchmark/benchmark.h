@@ -5,14 +5,77 @@
 #define BENCHMARK_H
 
 #include "../matrix/matrix.h"
+#include "timing.h"
 
+// side results of test_tiled that are not timings
+typedef struct {
+  double strassen_mem_mb;    // peak extra memory of the Strassen run
+  double strassen_max_error; // max abs difference to the ikj reference
+  double tiled_morton_convert_time;     // row-major <-> Z-order, in seconds
+  double recursive_morton_convert_time; // row-major <-> Z-order, in seconds
+} TiledReport;
+
+// product and run time of a serial baseline kernel on one input pair. They do
+// not depend on the thread count, chunk or block size, so one run serves the
+// whole sweep over those. With a cache directory they are also kept on disk
+// as <name>_n<size>_seed<seed>_f64.mat (+ .time), so runs with the same
+// --seed reuse them; the stored time comes from the run that wrote it, so use
+// one directory per build. cached marks such a time: the executables write it
+// to the BASELINE_CACHED column of the speedups computed against it
+typedef struct {
+  const char *name; // kernel name, part of the file name on disk
+  serial_loop_benchmark kernel;
+  int size;         // -1 while empty
+  double time;
+  int cached;       // time read from disk, not measured by this run
+  Matrix product;
+} ReferenceCache;
+
+// NULL (the default) keeps the references in memory only
+void set_reference_cache_directory(const char *directory);
+void reference_cache_init(ReferenceCache *cache, const char *name, serial_loop_benchmark kernel);
+// the baseline product of a * b, run (or read from disk) on the first call
+// after init/clear; *time receives the baseline run time
+const Matrix *reference_cache_get(ReferenceCache *cache, const Matrix *restrict a, const Matrix *restrict b,
+                                  double *time);
+// forgets the reference, to be called before the inputs change
+void reference_cache_clear(ReferenceCache *cache);
+
+// selects how the test_* functions check the products of the benchmarked
+// kernels (default: VALIDATE_REFERENCE)
+void set_validation_mode(ValidationMode mode, int freivalds_trials);
+// how often the test_* functions run each kernel (default: WARMUP_RUNS,
+// REPETITIONS, MAX_REPETITIONS, TARGET_CI); the reported time is the median
+// of the measured runs
+void set_timing_policy(const TimingPolicy *policy);
+// every kernel run of the test_* functions appends a row with its time,
+// GFLOP/s and position under the roofline (roofline.h) to kernel_metrics.csv,
+// plus its hardware counters (perf_counters.h, opened for thread_count
+// threads) with counters. Probes the 1 and thread_count thread rooflines and
+// records them in roofline.csv; other team sizes are probed on first use
+void set_kernel_metrics(int counters, int thread_count);
 void compute_speedup(double time_results[], double speedup_results[], int size);
-void test_serial_loop_permutations(double time_results[], const Matrix *restrict a, const Matrix *restrict b);
+void compute_gflops(double time_results[], double gflops_results[], int size, int matrix_size);
+// time_results[0] and the reference product come from the given cache, whose
+// kernel is the baseline named in the parameter (serial ijk or ikj)
+void test_serial_loop_permutations(double time_results[], ReferenceCache *reference_ijk, const Matrix *restrict a,
+                                   const Matrix *restrict b);
 void test_parallel_loop_permutations(double time_results[], const Matrix *restrict a, const Matrix *restrict b, int thread_count,
                                     int chunk);
-void test_serial_parallel_scaling_classic(double time_results[], const Matrix *restrict a, const Matrix *restrict b, int chunk_size);
-void test_serial_parallel_scaling_improved(double time_results[], const Matrix *restrict a, const Matrix *restrict b, int chunk_size);
-void test_tiled(double time_results[], const Matrix *restrict a, const Matrix *restrict b, int thread_count,
-                int block_size);
+void test_serial_parallel_scaling_classic(double time_results[], ReferenceCache *reference_ijk,
+                                          const Matrix *restrict a, const Matrix *restrict b, int chunk_size);
+void test_serial_parallel_scaling_improved(double time_results[], ReferenceCache *reference_ikj,
+                                           const Matrix *restrict a, const Matrix *restrict b, int chunk_size);
+void test_tiled(double time_results[], TiledReport *report, ReferenceCache *reference_ikj, const Matrix *restrict a,
+                const Matrix *restrict b, int thread_count, int block_size);
+// block-sparse inputs: serial tiled (reference), parallel tiled and the two
+// sparse-skipping tiled kernels; skipped_results[0/1] receive the skipped tile
+// products of the serial/parallel sparse kernels
+void test_sparse(double time_results[], size_t skipped_results[], const Matrix *restrict a,
+                 const Matrix *restrict b, int thread_count, int block_size);
+// batch_count products of matrix_size x matrix_size matrices: a loop over
+// parallel_multiply_ikj, gemm_batched, gemm_batched_strided and a loop over
+// adaptive_multiply_ikj
+void test_batched(double time_results[], int matrix_size, size_t batch_count, int thread_count);
 
 #endif // BENCHMARK_H
@@ -0,0 +1,88 @@
+#include "timing.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// a run is an outlier beyond this many scaled MADs from the median (the MAD
+// times 1.4826 estimates the standard deviation of normal samples)
+#define TIMING_OUTLIER_MADS 3.0
+#define TIMING_MAD_SCALE 1.4826
+// fewer runs give no usable MAD, so they are all kept
+#define TIMING_OUTLIER_MIN_RUNS 5
+
+// two-sided 95% quantiles of Student's t for 1..30 degrees of freedom
+static const double student_t95[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                     2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                     2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+static double t_quantile(int dof) {
+  const int table = (int)(sizeof(student_t95) / sizeof(student_t95[0]));
+  return (dof <= table) ? student_t95[dof - 1] : 1.960;
+}
+
+static int compare_doubles(const void *x, const void *y) {
+  const double a = *(const double *)x, b = *(const double *)y;
+  return (a > b) - (a < b);
+}
+
+static double sorted_median(const double *sorted, int count) {
+  return (count % 2 == 1) ? sorted[count / 2] : 0.5 * (sorted[count / 2 - 1] + sorted[count / 2]);
+}
+
+void timing_reset(TimingStats *stats) {
+  memset(stats, 0, sizeof(*stats));
+  stats->ci95 = INFINITY;
+}
+
+void timing_add(TimingStats *stats, double time) {
+  if (stats->runs == TIMING_MAX_SAMPLES) {
+    return;
+  }
+  stats->samples[stats->runs++] = time;
+  const int runs = stats->runs;
+
+  double sorted[TIMING_MAX_SAMPLES], deviations[TIMING_MAX_SAMPLES];
+  memcpy(sorted, stats->samples, (size_t)runs * sizeof(double));
+  qsort(sorted, (size_t)runs, sizeof(double), compare_doubles);
+  stats->min = sorted[0];
+  stats->median = sorted_median(sorted, runs);
+
+  for (int i = 0; i < runs; i++) {
+    deviations[i] = fabs(sorted[i] - stats->median);
+  }
+  qsort(deviations, (size_t)runs, sizeof(double), compare_doubles);
+  const double mad = sorted_median(deviations, runs);
+  const double limit = (runs < TIMING_OUTLIER_MIN_RUNS) ? 0.0 : TIMING_OUTLIER_MADS * TIMING_MAD_SCALE * mad;
+
+  // a limit of 0 keeps every run, also when the MAD is 0 (more than half of
+  // the runs equal)
+  int kept = 0;
+  double sum = 0.0;
+  for (int i = 0; i < runs; i++) {
+    if (limit == 0.0 || fabs(sorted[i] - stats->median) <= limit) {
+      sum += sorted[i];
+      kept++;
+    }
+  }
+  stats->outliers = runs - kept;
+  stats->mean = sum / kept;
+
+  double squares = 0.0;
+  for (int i = 0; i < runs; i++) {
+    if (limit == 0.0 || fabs(sorted[i] - stats->median) <= limit) {
+      squares += (sorted[i] - stats->mean) * (sorted[i] - stats->mean);
+    }
+  }
+  stats->stddev = (kept > 1) ? sqrt(squares / (kept - 1)) : 0.0;
+  stats->ci95 = (kept > 1) ? t_quantile(kept - 1) * stats->stddev / sqrt((double)kept) : INFINITY;
+}
+
+int timing_done(const TimingStats *stats, const TimingPolicy *policy) {
+  if (stats->runs >= policy->max_repetitions || stats->runs == TIMING_MAX_SAMPLES) {
+    return 1;
+  }
+  if (stats->runs < policy->min_repetitions) {
+    return 0;
+  }
+  return policy->target_ci <= 0.0 || stats->ci95 <= policy->target_ci * stats->mean;
+}
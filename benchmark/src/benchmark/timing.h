@@ -0,0 +1,53 @@
+// ABOUTME: Repeated kernel timing: warmup runs, then repetitions until a target confidence interval
+// ABOUTME: Min/median/mean/stddev/95% CI of the runs left after median-absolute-deviation outlier rejection
+
+#ifndef TIMING_H
+#define TIMING_H
+
+// upper bound of the measured runs of one kernel
+#define TIMING_MAX_SAMPLES 256
+
+typedef struct {
+  int warmup_runs;     // untimed runs before the first measured one
+  int min_repetitions; // measured runs that are always made
+  int max_repetitions; // measured runs after which the target is given up
+  double target_ci;    // relative half-width of the 95% CI of the mean to
+                       // stop at; 0 stops after min_repetitions
+} TimingPolicy;
+
+typedef struct {
+  double samples[TIMING_MAX_SAMPLES];
+  int runs;      // measured runs
+  int outliers;  // runs rejected by the median absolute deviation rule
+  double min;    // over all runs
+  double median; // over all runs
+  double mean;   // mean, stddev and ci95 over the runs that are not outliers
+  double stddev;
+  double ci95;   // half-width of the 95% confidence interval of the mean
+} TimingStats;
+
+// untimed runs of call, any expression, before the measured ones
+#define TIMING_WARMUP(policy, call)                                                                           \
+  do {                                                                                                        \
+    for (int warmup_ = 0; warmup_ < (policy)->warmup_runs; warmup_++) {                                       \
+      (void)(call);                                                                                           \
+    }                                                                                                         \
+  } while (0)
+
+// runs call, an expression returning the time of one kernel run, until the
+// policy is met and collects the times in *stats
+#define TIMING_REPEAT(policy, stats, call)                                                                    \
+  do {                                                                                                        \
+    timing_reset(stats);                                                                                      \
+    do {                                                                                                      \
+      timing_add(stats, (call));                                                                              \
+    } while (!timing_done(stats, policy));                                                                    \
+  } while (0)
+
+void timing_reset(TimingStats *stats);
+// records one run and updates the statistics
+void timing_add(TimingStats *stats, double time);
+// whether the policy needs no further run
+int timing_done(const TimingStats *stats, const TimingPolicy *policy);
+
+#endif // TIMING_H
@@ -0,0 +1,184 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "blocking.h"
+#include "microkernel.h"
+#include <stdio.h>
+#include <unistd.h>
+
+// used when neither sysconf nor sysfs report a cache level
+#define DEFAULT_L1D (32 * 1024)
+#define DEFAULT_L2 (256 * 1024)
+#define DEFAULT_L3 (8 * 1024 * 1024)
+
+static CacheSizes host_caches;
+static GemmBlocking host_blocking;
+static int host_detected = 0;
+
+// parses sysfs sizes such as "48K" or "2048K"
+static size_t sysfs_cache_size(int index, int *level, int *is_instruction) {
+  char path[128];
+  char buffer[64];
+  FILE *file;
+  unsigned long value = 0;
+  char unit = '\0';
+
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level",
+           index);
+  if ((file = fopen(path, "r")) == NULL) {
+    return 0;
+  }
+  if (fscanf(file, "%d", level) != 1) {
+    *level = 0;
+  }
+  fclose(file);
+
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type",
+           index);
+  if ((file = fopen(path, "r")) != NULL) {
+    *is_instruction = fgets(buffer, sizeof(buffer), file) != NULL &&
+                      buffer[0] == 'I';
+    fclose(file);
+  }
+
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size",
+           index);
+  if ((file = fopen(path, "r")) == NULL) {
+    return 0;
+  }
+  if (fscanf(file, "%lu%c", &value, &unit) < 1) {
+    value = 0;
+  }
+  fclose(file);
+
+  if (unit == 'K') {
+    value *= 1024;
+  } else if (unit == 'M') {
+    value *= 1024 * 1024;
+  }
+  return (size_t)value;
+}
+
+static size_t sysconf_cache_size(int name) {
+  long value = sysconf(name);
+  return (value > 0) ? (size_t)value : 0;
+}
+
+static void detect_cache_sizes(CacheSizes *caches) {
+  caches->l1d = caches->l2 = caches->l3 = 0;
+
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+  caches->l1d = sysconf_cache_size(_SC_LEVEL1_DCACHE_SIZE);
+  caches->l2 = sysconf_cache_size(_SC_LEVEL2_CACHE_SIZE);
+  caches->l3 = sysconf_cache_size(_SC_LEVEL3_CACHE_SIZE);
+#endif
+
+  for (int index = 0; index < 8; index++) {
+    int level = 0, is_instruction = 0;
+    size_t size = sysfs_cache_size(index, &level, &is_instruction);
+    if (size == 0 || is_instruction) {
+      continue;
+    }
+    if (level == 1 && caches->l1d == 0) {
+      caches->l1d = size;
+    } else if (level == 2 && caches->l2 == 0) {
+      caches->l2 = size;
+    } else if (level == 3 && caches->l3 == 0) {
+      caches->l3 = size;
+    }
+  }
+
+  if (caches->l1d == 0) {
+    caches->l1d = DEFAULT_L1D;
+  }
+  if (caches->l2 == 0) {
+    caches->l2 = DEFAULT_L2;
+  }
+  if (caches->l3 == 0) {
+    // no L3: let the B panel live in L2 next to the A block
+    caches->l3 = caches->l2;
+  }
+}
+
+static size_t round_down(size_t value, size_t multiple) {
+  size_t rounded = value / multiple * multiple;
+  return (rounded > 0) ? rounded : multiple;
+}
+
+// Each level keeps its operand in half of the cache, leaving the other half
+// for the operands streamed through it:
+//   kc x nr sliver of B in L1, mc x kc block of A in L2, kc x nc panel of B in L3
+static void derive_blocking(const CacheSizes *caches,
+                            const GemmMicroKernel *ukr,
+                            GemmBlocking *blocking) {
+  blocking->mr = ukr->mr;
+  blocking->nr = ukr->nr;
+  blocking->kc = round_down(caches->l1d / 2 / (ukr->nr * sizeof(double)), 8);
+  blocking->mc = round_down(
+      caches->l2 / 2 / (blocking->kc * sizeof(double)), ukr->mr);
+  blocking->nc = round_down(
+      caches->l3 / 2 / (blocking->kc * sizeof(double)), ukr->nr);
+}
+
+static void detect_host(void) {
+#pragma omp critical(gemm_host_blocking)
+  {
+    if (!host_detected) {
+      detect_cache_sizes(&host_caches);
+      derive_blocking(&host_caches, gemm_microkernel(), &host_blocking);
+      host_detected = 1;
+    }
+  }
+}
+
+const CacheSizes *host_cache_sizes(void) {
+  detect_host();
+  return &host_caches;
+}
+
+const GemmBlocking *gemm_host_blocking(void) {
+  detect_host();
+  return &host_blocking;
+}
+
+void gemm_blocking_select(int block_size, GemmBlocking *blocking) {
+  *blocking = *gemm_host_blocking();
+  if (block_size != BLOCK_SIZE_AUTO) {
+    blocking->mc = blocking->kc = blocking->nc = (size_t)block_size;
+  }
+}
+
+static size_t tile_count(size_t extent, size_t block) {
+  return (extent + block - 1) / block;
+}
+
+void gemm_blocking_balance(GemmBlocking *blocking, size_t m, size_t n,
+                           int thread_count) {
+  size_t mc = blocking->mc, nc = blocking->nc;
+  size_t m_max = (m + blocking->mr - 1) / blocking->mr * blocking->mr;
+  size_t n_max = (n + blocking->nr - 1) / blocking->nr * blocking->nr;
+  mc = (mc > m_max) ? m_max : mc;
+  nc = (nc > n_max) ? n_max : nc;
+
+  while (tile_count(m, mc) * tile_count(n, nc) < (size_t)thread_count) {
+    if (nc >= mc && nc > blocking->nr) {
+      nc = (nc / 2 + blocking->nr - 1) / blocking->nr * blocking->nr;
+    } else if (mc > blocking->mr) {
+      mc = (mc / 2 + blocking->mr - 1) / blocking->mr * blocking->mr;
+    } else {
+      break;
+    }
+  }
+
+  blocking->mc = mc;
+  blocking->nc = nc;
+}
+
+size_t host_square_tile(void) {
+  // three t x t tiles (A, B and C) in half of L2
+  const CacheSizes *caches = host_cache_sizes();
+  size_t tile = 8;
+  while (3 * (tile + 8) * (tile + 8) * sizeof(double) <= caches->l2 / 2) {
+    tile += 8;
+  }
+  return tile;
+}
@@ -0,0 +1,45 @@
+// ABOUTME: Cache-hierarchy-aware block sizes (mc/kc/nc) for the tiled and packed kernels
+// ABOUTME: Cache sizes are read from sysconf/sysfs at startup instead of being hand-tuned
+
+#ifndef BLOCKING_H
+#define BLOCKING_H
+
+#include <stddef.h>
+
+// block size value that selects the host-derived blocking
+#define BLOCK_SIZE_AUTO 0
+
+// data cache sizes in bytes
+typedef struct {
+  size_t l1d;
+  size_t l2;
+  size_t l3;
+} CacheSizes;
+
+// register tile (mr x nr) -> kc x nr B sliver in L1 -> mc x kc A block in L2
+// -> kc x nc B panel in L3
+typedef struct {
+  size_t mr;
+  size_t nr;
+  size_t mc;
+  size_t kc;
+  size_t nc;
+} GemmBlocking;
+
+const CacheSizes *host_cache_sizes(void);
+const GemmBlocking *gemm_host_blocking(void);
+
+// BLOCK_SIZE_AUTO selects the host blocking, any other value a square
+// block_size x block_size x block_size blocking
+void gemm_blocking_select(int block_size, GemmBlocking *blocking);
+
+// shrinks mc/nc (keeping multiples of mr/nr) until the m x n product has at
+// least one C tile per thread
+void gemm_blocking_balance(GemmBlocking *blocking, size_t m, size_t n,
+                           int thread_count);
+
+// side of a square tile such that one tile each of A, B and C fits in half of
+// L2, a multiple of 8
+size_t host_square_tile(void);
+
+#endif // BLOCKING_H
@@ -0,0 +1,238 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "gemm.h"
+#include "microkernel.h"
+#include "packing.h"
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static size_t round_up(size_t value, size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+static size_t min_size(size_t a, size_t b) { return (a < b) ? a : b; }
+
+static double *gemm_alloc(size_t count) {
+  void *buffer = NULL;
+  if (posix_memalign(&buffer, GEMM_ALIGNMENT, count * sizeof(double)) != 0) {
+    printf("Error: Failed to allocate memory for packing buffer\n");
+    exit(1);
+  }
+  return (double *)buffer;
+}
+
+// C (mc x nc) += packed A block * packed B panel
+static void macro_kernel(const GemmMicroKernel *ukr, size_t mc, size_t nc,
+                         size_t kc, const double *restrict a_packed,
+                         const double *restrict b_packed, double *restrict C,
+                         size_t ldc) {
+  const size_t mr = ukr->mr, nr = ukr->nr;
+  double edge[GEMM_MAX_MR * GEMM_MAX_NR];
+
+  for (size_t jr = 0; jr < nc; jr += nr) {
+    size_t cols = min_size(nr, nc - jr);
+    for (size_t ir = 0; ir < mc; ir += mr) {
+      size_t rows = min_size(mr, mc - ir);
+      double *c_tile = &C[ir * ldc + jr];
+
+      if (rows == mr && cols == nr) {
+        ukr->kernel(kc, &a_packed[ir * kc], &b_packed[jr * kc], c_tile, ldc);
+        continue;
+      }
+
+      // partial tile: compute the full register tile, keep the valid part
+      for (size_t t = 0; t < mr * nr; t++) {
+        edge[t] = 0.0;
+      }
+      ukr->kernel(kc, &a_packed[ir * kc], &b_packed[jr * kc], edge, nr);
+      for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+          c_tile[i * ldc + j] += edge[i * nr + j];
+        }
+      }
+    }
+  }
+}
+
+// C += alpha * op(A) * op(B) after C has been scaled by beta, with op()
+// folded into the row/column strides of A and B
+typedef struct {
+  const double *A;
+  size_t rsa, csa;
+  const double *B;
+  size_t rsb, csb;
+  double *C;
+  size_t ldc;
+  double alpha, beta;
+} GemmOperands;
+
+// C = beta * C on a rows x cols block; beta == 0 overwrites, so NaNs already
+// in C do not propagate
+static void scale_block(size_t rows, size_t cols, double beta,
+                        double *restrict C, size_t ldc) {
+  if (beta == 1.0) {
+    return;
+  }
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t j = 0; j < cols; j++) {
+      C[i * ldc + j] = (beta == 0.0) ? 0.0 : beta * C[i * ldc + j];
+    }
+  }
+}
+
+static void gemm_run_serial(size_t m, size_t n, size_t k,
+                            const GemmOperands *op,
+                            const GemmBlocking *blocking) {
+  const GemmMicroKernel *ukr = gemm_microkernel();
+  const size_t mr = ukr->mr, nr = ukr->nr;
+  const size_t mc = min_size(round_up(blocking->mc, mr), round_up(m, mr));
+  const size_t nc = min_size(round_up(blocking->nc, nr), round_up(n, nr));
+  const size_t kc = min_size(blocking->kc, k);
+  double *restrict C = op->C;
+  const size_t ldc = op->ldc;
+
+  double *a_packed = gemm_alloc(mc * kc);
+  double *b_packed = gemm_alloc(kc * nc);
+
+  for (size_t jc = 0; jc < n; jc += nc) {
+    size_t nb = min_size(nc, n - jc);
+    for (size_t pc = 0; pc < k; pc += kc) {
+      size_t kb = min_size(kc, k - pc);
+      pack_panel_b(kb, nb, &op->B[pc * op->rsb + jc * op->csb], op->rsb,
+                   op->csb, b_packed, nr);
+      for (size_t ic = 0; ic < m; ic += mc) {
+        size_t mb = min_size(mc, m - ic);
+        pack_block_a(mb, kb, &op->A[ic * op->rsa + pc * op->csa], op->rsa,
+                     op->csa, op->alpha, a_packed, mr);
+        // beta is applied right before the first update of the block, while
+        // the block is about to be in cache anyway
+        if (pc == 0) {
+          scale_block(mb, nb, op->beta, &C[ic * ldc + jc], ldc);
+        }
+        macro_kernel(ukr, mb, nb, kb, a_packed, b_packed, &C[ic * ldc + jc],
+                     ldc);
+      }
+    }
+  }
+
+  free(a_packed);
+  free(b_packed);
+}
+
+static void gemm_run_parallel(size_t m, size_t n, size_t k,
+                              const GemmOperands *op,
+                              const GemmBlocking *blocking, int thread_count) {
+  const GemmMicroKernel *ukr = gemm_microkernel();
+  const size_t mr = ukr->mr, nr = ukr->nr;
+  // the ic loop is the parallel one: keep at least one A block per thread
+  const size_t threads = (size_t)thread_count;
+  const size_t mc_balanced = round_up((m + threads - 1) / threads, mr);
+  const size_t mc = min_size(round_up(blocking->mc, mr), mc_balanced);
+  const size_t nc = min_size(round_up(blocking->nc, nr), round_up(n, nr));
+  const size_t kc = min_size(blocking->kc, k);
+  double *restrict C = op->C;
+  const size_t ldc = op->ldc;
+
+  // one B panel shared by the team, one A block per thread
+  double *b_packed = gemm_alloc(kc * nc);
+
+#pragma omp parallel num_threads(thread_count), default(none),                 \
+    shared(ukr, mr, nr, m, n, k, op, C, ldc, mc, kc, nc, b_packed)
+  {
+    double *a_packed = gemm_alloc(mc * kc);
+
+    for (size_t jc = 0; jc < n; jc += nc) {
+      size_t nb = min_size(nc, n - jc);
+      for (size_t pc = 0; pc < k; pc += kc) {
+        size_t kb = min_size(kc, k - pc);
+
+        // the implicit barrier publishes the packed panel to every thread
+#pragma omp for schedule(static)
+        for (size_t jr = 0; jr < nb; jr += nr) {
+          pack_sliver_b(kb, min_size(nr, nb - jr),
+                        &op->B[pc * op->rsb + (jc + jr) * op->csb], op->rsb,
+                        op->csb, &b_packed[jr * kb], nr);
+        }
+
+        // the implicit barrier keeps the panel alive until all blocks are done
+#pragma omp for schedule(static)
+        for (size_t ic = 0; ic < m; ic += mc) {
+          size_t mb = min_size(mc, m - ic);
+          pack_block_a(mb, kb, &op->A[ic * op->rsa + pc * op->csa], op->rsa,
+                       op->csa, op->alpha, a_packed, mr);
+          if (pc == 0) {
+            scale_block(mb, nb, op->beta, &C[ic * ldc + jc], ldc);
+          }
+          macro_kernel(ukr, mb, nb, kb, a_packed, b_packed, &C[ic * ldc + jc],
+                       ldc);
+        }
+      }
+    }
+
+    free(a_packed);
+  }
+
+  free(b_packed);
+}
+
+void gemm_packed_serial(size_t m, size_t n, size_t k, const double *restrict A,
+                        size_t lda, const double *restrict B, size_t ldb,
+                        double *restrict C, size_t ldc,
+                        const GemmBlocking *blocking) {
+  if (m == 0 || n == 0 || k == 0) {
+    return;
+  }
+  const GemmOperands op = {A, lda, 1, B, ldb, 1, C, ldc, 1.0, 1.0};
+  gemm_run_serial(m, n, k, &op, blocking);
+}
+
+void gemm_packed_parallel(size_t m, size_t n, size_t k,
+                          const double *restrict A, size_t lda,
+                          const double *restrict B, size_t ldb,
+                          double *restrict C, size_t ldc,
+                          const GemmBlocking *blocking, int thread_count) {
+  if (m == 0 || n == 0 || k == 0) {
+    return;
+  }
+  const GemmOperands op = {A, lda, 1, B, ldb, 1, C, ldc, 1.0, 1.0};
+  gemm_run_parallel(m, n, k, &op, blocking, thread_count);
+}
+
+void dgemm(GemmTranspose transa, GemmTranspose transb, size_t m, size_t n,
+           size_t k, double alpha, const double *A, size_t lda,
+           const double *B, size_t ldb, double beta, double *C, size_t ldc,
+           const GemmBlocking *blocking, int thread_count) {
+  if (m == 0 || n == 0) {
+    return;
+  }
+  if (k == 0 || alpha == 0.0) {
+    // no product to add, C only needs scaling; thread_count <= 1 stays serial
+    const int team = (thread_count > 1) ? thread_count : 1;
+#pragma omp parallel for num_threads(team) default(none) shared(m, n, beta, C, ldc)
+    for (size_t i = 0; i < m; i++) {
+      scale_block(1, n, beta, &C[i * ldc], ldc);
+    }
+    return;
+  }
+
+  const int ta = (transa == GEMM_TRANS), tb = (transb == GEMM_TRANS);
+  const GemmOperands op = {
+      .A = A, .rsa = ta ? 1 : lda, .csa = ta ? lda : 1,
+      .B = B, .rsb = tb ? 1 : ldb, .csb = tb ? ldb : 1,
+      .C = C, .ldc = ldc,          .alpha = alpha, .beta = beta,
+  };
+
+  // no balancing: the parallel engine splits only the ic loop and already
+  // shrinks mc to one A block per thread, so a smaller nc would only add
+  // B panel rounds
+  if (blocking == NULL) {
+    blocking = gemm_host_blocking();
+  }
+
+  if (thread_count <= 1) {
+    gemm_run_serial(m, n, k, &op, blocking);
+  } else {
+    gemm_run_parallel(m, n, k, &op, blocking, thread_count);
+  }
+}
@@ -0,0 +1,38 @@
+// ABOUTME: Packed-panel GEMM engine following the GotoBLAS/BLIS loop structure
+// ABOUTME: DGEMM-style C = alpha * op(A) * op(B) + beta * C on raw row-major buffers
+
+#ifndef GEMM_H
+#define GEMM_H
+
+#include "blocking.h"
+#include <stddef.h>
+
+// alignment (in bytes) of the packing buffers
+#define GEMM_ALIGNMENT 64
+
+// C (m x n) += A (m x k) * B (k x n)
+// mc x kc blocks of A are packed per thread, kc x nc panels of B are shared
+void gemm_packed_serial(size_t m, size_t n, size_t k, const double *restrict A,
+                        size_t lda, const double *restrict B, size_t ldb,
+                        double *restrict C, size_t ldc,
+                        const GemmBlocking *blocking);
+void gemm_packed_parallel(size_t m, size_t n, size_t k,
+                          const double *restrict A, size_t lda,
+                          const double *restrict B, size_t ldb,
+                          double *restrict C, size_t ldc,
+                          const GemmBlocking *blocking, int thread_count);
+
+typedef enum { GEMM_NO_TRANS, GEMM_TRANS } GemmTranspose;
+
+// C (m x n) = alpha * op(A) * op(B) + beta * C, where op(A) is m x k and op(B)
+// is k x n. All operands are row-major with leading dimensions lda/ldb/ldc; a
+// transposed operand is read in place through its packing, never copied.
+// beta is applied block by block inside the engine instead of in a separate
+// pass over C, and beta == 0 ignores the old contents of C. A NULL blocking
+// selects the host blocking; thread_count <= 1 runs the serial engine
+void dgemm(GemmTranspose transa, GemmTranspose transb, size_t m, size_t n,
+           size_t k, double alpha, const double *A, size_t lda,
+           const double *B, size_t ldb, double beta, double *C, size_t ldc,
+           const GemmBlocking *blocking, int thread_count);
+
+#endif // GEMM_H
@@ -0,0 +1,98 @@
+#include "microkernel.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// portable fallback: constant bounds let the compiler keep acc in registers
+#define SCALAR_MR 4
+#define SCALAR_NR 8
+
+static void microkernel_scalar_4x8(size_t kc, const double *restrict a,
+                                   const double *restrict b,
+                                   double *restrict c, size_t ldc) {
+  double acc[SCALAR_MR][SCALAR_NR] = {{0.0}};
+
+  for (size_t p = 0; p < kc; p++) {
+    for (size_t i = 0; i < SCALAR_MR; i++) {
+      const double temp = a[p * SCALAR_MR + i];
+      for (size_t j = 0; j < SCALAR_NR; j++) {
+        acc[i][j] += temp * b[p * SCALAR_NR + j];
+      }
+    }
+  }
+
+  for (size_t i = 0; i < SCALAR_MR; i++) {
+    for (size_t j = 0; j < SCALAR_NR; j++) {
+      c[i * ldc + j] += acc[i][j];
+    }
+  }
+}
+
+const GemmMicroKernel microkernel_scalar = {
+    "scalar-4x8", "scalar", SCALAR_MR, SCALAR_NR, microkernel_scalar_4x8};
+
+static const GemmMicroKernel *selected_microkernel = NULL;
+
+#ifdef GEMM_SIMD_KERNELS
+static const GemmMicroKernel *const simd_microkernels[] = {
+    &microkernel_avx512, &microkernel_avx2, &microkernel_sse2};
+
+static int host_supports(const GemmMicroKernel *ukr) {
+  __builtin_cpu_init();
+  if (ukr == &microkernel_avx512) {
+    return __builtin_cpu_supports("avx512f");
+  }
+  if (ukr == &microkernel_avx2) {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  }
+  return __builtin_cpu_supports("sse2");
+}
+#endif
+
+static const GemmMicroKernel *select_microkernel(void) {
+  // GEMM_ISA=<isa> caps the dispatch, e.g. to compare ISAs on one host: the
+  // best kernel the host supports from that ISA down
+  const char *requested = getenv("GEMM_ISA");
+  int capped = requested != NULL && strlen(requested) > 0;
+  if (capped && strcmp(requested, microkernel_scalar.isa) == 0) {
+    return &microkernel_scalar;
+  }
+
+#ifdef GEMM_SIMD_KERNELS
+  int count = sizeof(simd_microkernels) / sizeof(simd_microkernels[0]);
+  int first = 0;
+  if (capped) {
+    while (first < count && strcmp(requested, simd_microkernels[first]->isa) != 0) {
+      first++;
+    }
+  }
+  if (first == count) {
+    printf("Warning: unknown GEMM_ISA=%s, using the best kernel of this host\n",
+           requested);
+    first = 0;
+  }
+  for (int i = first; i < count; i++) {
+    if (host_supports(simd_microkernels[i])) {
+      return simd_microkernels[i];
+    }
+  }
+#else
+  if (capped) {
+    printf("Warning: GEMM_ISA=%s is not built, using %s\n", requested,
+           microkernel_scalar.isa);
+  }
+#endif
+
+  return &microkernel_scalar;
+}
+
+const GemmMicroKernel *gemm_microkernel(void) {
+#pragma omp critical(gemm_microkernel_dispatch)
+  {
+    if (selected_microkernel == NULL) {
+      selected_microkernel = select_microkernel();
+    }
+  }
+  return selected_microkernel;
+}
@@ -0,0 +1,36 @@
+// ABOUTME: Register-blocked GEMM micro-kernels (scalar, SSE2, AVX2/FMA, AVX-512F)
+// ABOUTME: Each kernel keeps an mr x nr tile of C in registers across the whole k loop
+
+#ifndef MICROKERNEL_H
+#define MICROKERNEL_H
+
+#include <stddef.h>
+
+// largest register tile of any micro-kernel, sizes the edge scratch tiles
+#define GEMM_MAX_MR 8
+#define GEMM_MAX_NR 16
+
+// C (mr x nr) += packed A sliver (kc x mr) * packed B sliver (kc x nr)
+typedef void (*gemm_microkernel_fn)(size_t kc, const double *restrict a,
+                                    const double *restrict b,
+                                    double *restrict c, size_t ldc);
+
+typedef struct {
+  const char *name;
+  const char *isa;
+  size_t mr;
+  size_t nr;
+  gemm_microkernel_fn kernel;
+} GemmMicroKernel;
+
+// each SIMD kernel lives in its own translation unit compiled for its ISA;
+// they are only linked in when the build defines GEMM_SIMD_KERNELS
+extern const GemmMicroKernel microkernel_scalar;
+extern const GemmMicroKernel microkernel_sse2;
+extern const GemmMicroKernel microkernel_avx2;
+extern const GemmMicroKernel microkernel_avx512;
+
+// best micro-kernel the running CPU supports, chosen once via cpuid
+const GemmMicroKernel *gemm_microkernel(void);
+
+#endif // MICROKERNEL_H
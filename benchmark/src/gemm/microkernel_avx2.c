@@ -0,0 +1,64 @@
+#include "microkernel.h"
+#include <immintrin.h>
+
+#if !defined(__AVX2__) || !defined(__FMA__)
+#error "microkernel_avx2.c must be compiled with -mavx2 -mfma"
+#endif
+
+// 6 rows x 2 ymm: 12 accumulators + 2 B vectors + 1 broadcast of 16 registers
+static void microkernel_avx2_6x8(size_t kc, const double *restrict a,
+                                 const double *restrict b, double *restrict c,
+                                 size_t ldc) {
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+  __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+  __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+  for (size_t p = 0; p < kc; p++) {
+    const __m256d b0 = _mm256_loadu_pd(&b[0]);
+    const __m256d b1 = _mm256_loadu_pd(&b[4]);
+    __m256d ai;
+
+    ai = _mm256_broadcast_sd(&a[0]);
+    c00 = _mm256_fmadd_pd(ai, b0, c00);
+    c01 = _mm256_fmadd_pd(ai, b1, c01);
+    ai = _mm256_broadcast_sd(&a[1]);
+    c10 = _mm256_fmadd_pd(ai, b0, c10);
+    c11 = _mm256_fmadd_pd(ai, b1, c11);
+    ai = _mm256_broadcast_sd(&a[2]);
+    c20 = _mm256_fmadd_pd(ai, b0, c20);
+    c21 = _mm256_fmadd_pd(ai, b1, c21);
+    ai = _mm256_broadcast_sd(&a[3]);
+    c30 = _mm256_fmadd_pd(ai, b0, c30);
+    c31 = _mm256_fmadd_pd(ai, b1, c31);
+    ai = _mm256_broadcast_sd(&a[4]);
+    c40 = _mm256_fmadd_pd(ai, b0, c40);
+    c41 = _mm256_fmadd_pd(ai, b1, c41);
+    ai = _mm256_broadcast_sd(&a[5]);
+    c50 = _mm256_fmadd_pd(ai, b0, c50);
+    c51 = _mm256_fmadd_pd(ai, b1, c51);
+
+    a += 6;
+    b += 8;
+  }
+
+#define AVX2_STORE_ROW(row, lo, hi)                                            \
+  _mm256_storeu_pd(&c[(row) * ldc],                                            \
+                   _mm256_add_pd(_mm256_loadu_pd(&c[(row) * ldc]), lo));       \
+  _mm256_storeu_pd(&c[(row) * ldc + 4],                                        \
+                   _mm256_add_pd(_mm256_loadu_pd(&c[(row) * ldc + 4]), hi))
+
+  AVX2_STORE_ROW(0, c00, c01);
+  AVX2_STORE_ROW(1, c10, c11);
+  AVX2_STORE_ROW(2, c20, c21);
+  AVX2_STORE_ROW(3, c30, c31);
+  AVX2_STORE_ROW(4, c40, c41);
+  AVX2_STORE_ROW(5, c50, c51);
+
+#undef AVX2_STORE_ROW
+}
+
+const GemmMicroKernel microkernel_avx2 = {"avx2-fma-6x8", "avx2-fma", 6, 8,
+                                          microkernel_avx2_6x8};
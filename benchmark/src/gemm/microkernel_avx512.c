@@ -0,0 +1,74 @@
+#include "microkernel.h"
+#include <immintrin.h>
+
+#if !defined(__AVX512F__)
+#error "microkernel_avx512.c must be compiled with -mavx512f"
+#endif
+
+// 8 rows x 2 zmm: 16 accumulators + 2 B vectors + 1 broadcast of 32 registers
+static void microkernel_avx512_8x16(size_t kc, const double *restrict a,
+                                    const double *restrict b,
+                                    double *restrict c, size_t ldc) {
+  __m512d c00 = _mm512_setzero_pd(), c01 = _mm512_setzero_pd();
+  __m512d c10 = _mm512_setzero_pd(), c11 = _mm512_setzero_pd();
+  __m512d c20 = _mm512_setzero_pd(), c21 = _mm512_setzero_pd();
+  __m512d c30 = _mm512_setzero_pd(), c31 = _mm512_setzero_pd();
+  __m512d c40 = _mm512_setzero_pd(), c41 = _mm512_setzero_pd();
+  __m512d c50 = _mm512_setzero_pd(), c51 = _mm512_setzero_pd();
+  __m512d c60 = _mm512_setzero_pd(), c61 = _mm512_setzero_pd();
+  __m512d c70 = _mm512_setzero_pd(), c71 = _mm512_setzero_pd();
+
+  for (size_t p = 0; p < kc; p++) {
+    const __m512d b0 = _mm512_loadu_pd(&b[0]);
+    const __m512d b1 = _mm512_loadu_pd(&b[8]);
+    __m512d ai;
+
+    ai = _mm512_set1_pd(a[0]);
+    c00 = _mm512_fmadd_pd(ai, b0, c00);
+    c01 = _mm512_fmadd_pd(ai, b1, c01);
+    ai = _mm512_set1_pd(a[1]);
+    c10 = _mm512_fmadd_pd(ai, b0, c10);
+    c11 = _mm512_fmadd_pd(ai, b1, c11);
+    ai = _mm512_set1_pd(a[2]);
+    c20 = _mm512_fmadd_pd(ai, b0, c20);
+    c21 = _mm512_fmadd_pd(ai, b1, c21);
+    ai = _mm512_set1_pd(a[3]);
+    c30 = _mm512_fmadd_pd(ai, b0, c30);
+    c31 = _mm512_fmadd_pd(ai, b1, c31);
+    ai = _mm512_set1_pd(a[4]);
+    c40 = _mm512_fmadd_pd(ai, b0, c40);
+    c41 = _mm512_fmadd_pd(ai, b1, c41);
+    ai = _mm512_set1_pd(a[5]);
+    c50 = _mm512_fmadd_pd(ai, b0, c50);
+    c51 = _mm512_fmadd_pd(ai, b1, c51);
+    ai = _mm512_set1_pd(a[6]);
+    c60 = _mm512_fmadd_pd(ai, b0, c60);
+    c61 = _mm512_fmadd_pd(ai, b1, c61);
+    ai = _mm512_set1_pd(a[7]);
+    c70 = _mm512_fmadd_pd(ai, b0, c70);
+    c71 = _mm512_fmadd_pd(ai, b1, c71);
+
+    a += 8;
+    b += 16;
+  }
+
+#define AVX512_STORE_ROW(row, lo, hi)                                          \
+  _mm512_storeu_pd(&c[(row) * ldc],                                            \
+                   _mm512_add_pd(_mm512_loadu_pd(&c[(row) * ldc]), lo));       \
+  _mm512_storeu_pd(&c[(row) * ldc + 8],                                        \
+                   _mm512_add_pd(_mm512_loadu_pd(&c[(row) * ldc + 8]), hi))
+
+  AVX512_STORE_ROW(0, c00, c01);
+  AVX512_STORE_ROW(1, c10, c11);
+  AVX512_STORE_ROW(2, c20, c21);
+  AVX512_STORE_ROW(3, c30, c31);
+  AVX512_STORE_ROW(4, c40, c41);
+  AVX512_STORE_ROW(5, c50, c51);
+  AVX512_STORE_ROW(6, c60, c61);
+  AVX512_STORE_ROW(7, c70, c71);
+
+#undef AVX512_STORE_ROW
+}
+
+const GemmMicroKernel microkernel_avx512 = {"avx512f-8x16", "avx512f", 8,
+                                            16, microkernel_avx512_8x16};
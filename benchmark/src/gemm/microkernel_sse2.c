@@ -0,0 +1,54 @@
+#include "microkernel.h"
+#include <emmintrin.h>
+
+#if !defined(__SSE2__)
+#error "microkernel_sse2.c must be compiled with -msse2"
+#endif
+
+// 4 rows x 2 xmm: 8 accumulators + 2 B vectors + 1 broadcast of 16 registers
+static void microkernel_sse2_4x4(size_t kc, const double *restrict a,
+                                 const double *restrict b, double *restrict c,
+                                 size_t ldc) {
+  __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+  __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+  __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+  __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+
+  for (size_t p = 0; p < kc; p++) {
+    const __m128d b0 = _mm_loadu_pd(&b[0]);
+    const __m128d b1 = _mm_loadu_pd(&b[2]);
+    __m128d ai;
+
+    ai = _mm_set1_pd(a[0]);
+    c00 = _mm_add_pd(c00, _mm_mul_pd(ai, b0));
+    c01 = _mm_add_pd(c01, _mm_mul_pd(ai, b1));
+    ai = _mm_set1_pd(a[1]);
+    c10 = _mm_add_pd(c10, _mm_mul_pd(ai, b0));
+    c11 = _mm_add_pd(c11, _mm_mul_pd(ai, b1));
+    ai = _mm_set1_pd(a[2]);
+    c20 = _mm_add_pd(c20, _mm_mul_pd(ai, b0));
+    c21 = _mm_add_pd(c21, _mm_mul_pd(ai, b1));
+    ai = _mm_set1_pd(a[3]);
+    c30 = _mm_add_pd(c30, _mm_mul_pd(ai, b0));
+    c31 = _mm_add_pd(c31, _mm_mul_pd(ai, b1));
+
+    a += 4;
+    b += 4;
+  }
+
+#define SSE2_STORE_ROW(row, lo, hi)                                            \
+  _mm_storeu_pd(&c[(row) * ldc],                                               \
+                _mm_add_pd(_mm_loadu_pd(&c[(row) * ldc]), lo));                \
+  _mm_storeu_pd(&c[(row) * ldc + 2],                                           \
+                _mm_add_pd(_mm_loadu_pd(&c[(row) * ldc + 2]), hi))
+
+  SSE2_STORE_ROW(0, c00, c01);
+  SSE2_STORE_ROW(1, c10, c11);
+  SSE2_STORE_ROW(2, c20, c21);
+  SSE2_STORE_ROW(3, c30, c31);
+
+#undef SSE2_STORE_ROW
+}
+
+const GemmMicroKernel microkernel_sse2 = {"sse2-4x4", "sse2", 4, 4,
+                                          microkernel_sse2_4x4};
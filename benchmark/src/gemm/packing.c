@@ -0,0 +1,46 @@
+#include "packing.h"
+
+void pack_sliver_a(size_t rows, size_t kc, const double *restrict A, size_t rsa,
+                   size_t csa, double alpha, double *restrict buffer,
+                   size_t mr) {
+  for (size_t p = 0; p < kc; p++) {
+    size_t i = 0;
+    for (; i < rows; i++) {
+      buffer[p * mr + i] = alpha * A[i * rsa + p * csa];
+    }
+    for (; i < mr; i++) {
+      buffer[p * mr + i] = 0.0;
+    }
+  }
+}
+
+void pack_sliver_b(size_t kc, size_t cols, const double *restrict B, size_t rsb,
+                   size_t csb, double *restrict buffer, size_t nr) {
+  for (size_t p = 0; p < kc; p++) {
+    size_t j = 0;
+    for (; j < cols; j++) {
+      buffer[p * nr + j] = B[p * rsb + j * csb];
+    }
+    for (; j < nr; j++) {
+      buffer[p * nr + j] = 0.0;
+    }
+  }
+}
+
+void pack_block_a(size_t mc, size_t kc, const double *restrict A, size_t rsa,
+                  size_t csa, double alpha, double *restrict buffer,
+                  size_t mr) {
+  for (size_t ir = 0; ir < mc; ir += mr) {
+    size_t rows = (ir + mr > mc) ? mc - ir : mr;
+    pack_sliver_a(rows, kc, &A[ir * rsa], rsa, csa, alpha, &buffer[ir * kc],
+                  mr);
+  }
+}
+
+void pack_panel_b(size_t kc, size_t nc, const double *restrict B, size_t rsb,
+                  size_t csb, double *restrict buffer, size_t nr) {
+  for (size_t jr = 0; jr < nc; jr += nr) {
+    size_t cols = (jr + nr > nc) ? nc - jr : nr;
+    pack_sliver_b(kc, cols, &B[jr * csb], rsb, csb, &buffer[jr * kc], nr);
+  }
+}
@@ -0,0 +1,27 @@
+// ABOUTME: Packing routines that copy blocks of A and panels of B into contiguous buffers
+// ABOUTME: Buffers are laid out in the order the GEMM micro-kernel consumes them
+
+#ifndef PACKING_H
+#define PACKING_H
+
+#include <stddef.h>
+
+// An A sliver is mr rows of A stored column by column (mr values per k),
+// a B sliver is nr columns of B stored row by row (nr values per k).
+// Slivers shorter than mr / nr are padded with zeros.
+//
+// Sources are read through a row stride rs and a column stride cs: element
+// (i, j) is at X[i * rs + j * cs], so a row-major operand has (ld, 1) and a
+// transposed one (1, ld). A is scaled by alpha while it is packed.
+void pack_sliver_a(size_t rows, size_t kc, const double *restrict A, size_t rsa,
+                   size_t csa, double alpha, double *restrict buffer,
+                   size_t mr);
+void pack_sliver_b(size_t kc, size_t cols, const double *restrict B, size_t rsb,
+                   size_t csb, double *restrict buffer, size_t nr);
+
+void pack_block_a(size_t mc, size_t kc, const double *restrict A, size_t rsa,
+                  size_t csa, double alpha, double *restrict buffer, size_t mr);
+void pack_panel_b(size_t kc, size_t nc, const double *restrict B, size_t rsb,
+                  size_t csb, double *restrict buffer, size_t nr);
+
+#endif // PACKING_H
@@ -8,22 +8,27 @@ parallel_loop_benchmark parallel_loop_benchmark_functions[] = {
 
 double parallel_multiply_ijk(const Matrix *restrict a, const Matrix *restrict b,
                              Matrix *restrict c, int thread_count, int chunk) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  size_t i, j, k;
   matrix_fill_zero(c);
-  int i, j, k, n = a->size;
   double temp;
   double start = omp_get_wtime();
 
 #pragma omp parallel num_threads(thread_count), default(none),                 \
-    private(i, j, k, temp), shared(a, b, c, chunk, n)
+    private(i, j, k, temp), shared(A, B, C, lda, ldb, ldc, chunk, n)
   {
 #pragma omp for schedule(static, chunk)
     for (i = 0; i < n; i++) {
       for (j = 0; j < n; j++) {
         temp = 0;
         for (k = 0; k < n; k++) {
-          temp += a->data[i][k] * b->data[k][j];
+          temp += A[i * lda + k] * B[k * ldb + j];
         }
-        c->data[i][j] = temp;
+        C[i * ldc + j] = temp;
       }
     }
   }
@@ -41,21 +46,26 @@ double parallel_multiply_ijk(const Matrix *restrict a, const Matrix *restrict b,
 
 double parallel_multiply_ikj(const Matrix *restrict a, const Matrix *restrict b,
                              Matrix *restrict c, int thread_count, int chunk) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  size_t i, j, k;
   matrix_fill_zero(c);
-  int i, j, k, n = a->size;
   double temp;
   double start = omp_get_wtime();
 
 #pragma omp parallel num_threads(thread_count), default(none),                 \
-    private(i, j, k, temp), shared(a, b, c, chunk, n)
+    private(i, j, k, temp), shared(A, B, C, lda, ldb, ldc, chunk, n)
   {
 
 #pragma omp for schedule(static, chunk)
     for (i = 0; i < n; i++) {
       for (k = 0; k < n; k++) {
-        temp = a->data[i][k];
+        temp = A[i * lda + k];
         for (j = 0; j < n; j++) {
-          c->data[i][j] += temp * b->data[k][j];
+          C[i * ldc + j] += temp * B[k * ldb + j];
         }
       }
     }
@@ -74,22 +84,27 @@ double parallel_multiply_ikj(const Matrix *restrict a, const Matrix *restrict b,
 
 double parallel_multiply_jik(const Matrix *restrict a, const Matrix *restrict b,
                              Matrix *restrict c, int thread_count, int chunk) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  size_t i, j, k;
   matrix_fill_zero(c);
-  int i, j, k, n = a->size;
   double temp;
   double start = omp_get_wtime();
 
 #pragma omp parallel num_threads(thread_count), default(none),                 \
-    private(i, j, k, temp), shared(a, b, c, chunk, n)
+    private(i, j, k, temp), shared(A, B, C, lda, ldb, ldc, chunk, n)
   {
 #pragma omp for schedule(static, chunk)
     for (j = 0; j < n; j++) {
       for (i = 0; i < n; i++) {
         temp = 0;
         for (k = 0; k < n; k++) {
-          temp += a->data[i][k] * b->data[k][j];
+          temp += A[i * lda + k] * B[k * ldb + j];
         }
-        c->data[i][j] = temp;
+        C[i * ldc + j] = temp;
       }
     }
   }
@@ -107,21 +122,26 @@ double parallel_multiply_jik(const Matrix *restrict a, const Matrix *restrict b,
 
 double parallel_multiply_jki(const Matrix *restrict a, const Matrix *restrict b,
                              Matrix *restrict c, int thread_count, int chunk) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  size_t i, j, k;
   matrix_fill_zero(c);
-  int i, j, k, n = a->size;
   double temp;
 
   double start = omp_get_wtime();
 
 #pragma omp parallel num_threads(thread_count), default(none),                 \
-    private(i, j, k, temp), shared(a, b, c, chunk, n)
+    private(i, j, k, temp), shared(A, B, C, lda, ldb, ldc, chunk, n)
   {
 #pragma omp for schedule(static, chunk)
     for (j = 0; j < n; j++) {
       for (k = 0; k < n; k++) {
-        temp = b->data[k][j];
+        temp = B[k * ldb + j];
         for (i = 0; i < n; i++) {
-          c->data[i][j] += a->data[i][k] * temp;
+          C[i * ldc + j] += A[i * lda + k] * temp;
         }
       }
     }
@@ -140,21 +160,26 @@ double parallel_multiply_jki(const Matrix *restrict a, const Matrix *restrict b,
 
 double parallel_multiply_kij(const Matrix *restrict a, const Matrix *restrict b,
                              Matrix *restrict c, int thread_count, int chunk) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  size_t i, j, k;
   matrix_fill_zero(c);
-  int i, j, k, n = a->size;
   double temp;
 
   double start = omp_get_wtime();
 
 #pragma omp parallel num_threads(thread_count), default(none),                 \
-    private(i, j, k, temp), shared(a, b, c, chunk, n)
+    private(i, j, k, temp), shared(A, B, C, lda, ldb, ldc, chunk, n)
   {
     for (k = 0; k < n; k++) {
 #pragma omp for schedule(static, chunk) nowait
       for (i = 0; i < n; i++) {
-        temp = a->data[i][k];
+        temp = A[i * lda + k];
         for (j = 0; j < n; j++) {
-          c->data[i][j] += temp * b->data[k][j];
+          C[i * ldc + j] += temp * B[k * ldb + j];
         }
       }
     }
@@ -173,22 +198,26 @@ double parallel_multiply_kij(const Matrix *restrict a, const Matrix *restrict b,
 
 double parallel_multiply_kji(const Matrix *restrict a, const Matrix *restrict b,
                              Matrix *restrict c, int thread_count, int chunk) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  size_t i, j, k;
   matrix_fill_zero(c);
-  int n = a->size;
-  int i, j, k;
   double temp;
 
   double start = omp_get_wtime();
 
 #pragma omp parallel num_threads(thread_count), default(none),                 \
-    private(i, j, k, temp), shared(a, b, c, chunk, n)
+    private(i, j, k, temp), shared(A, B, C, lda, ldb, ldc, chunk, n)
   {
     for (k = 0; k < n; k++) {
 #pragma omp for schedule(static, chunk) nowait
       for (j = 0; j < n; j++) {
-        temp = b->data[k][j];
+        temp = B[k * ldb + j];
         for (i = 0; i < n; i++) {
-          c->data[i][j] += a->data[i][k] * temp;
+          C[i * ldc + j] += A[i * lda + k] * temp;
         }
       }
     }
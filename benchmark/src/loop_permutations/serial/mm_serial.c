@@ -1,4 +1,5 @@
 #include "mm_serial.h"
+#include "mm_serial_fixed.h"
 #include "../../main/parameters.h"
 #include <omp.h>
 
@@ -7,15 +8,22 @@ serial_loop_benchmark serial_loop_benchmark_functions[] = {
     serial_multiply_jki, serial_multiply_kij, serial_multiply_kji};
 
 double serial_multiply_ijk(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
   matrix_fill_zero(c);
 
   double start = omp_get_wtime();
 
-  for (int i = 0; i < a->size; i++)
-    for (int j = 0; j < a->size; j++)
-      for (int k = 0; k < a->size; k++) {
-        c->data[i][j] += a->data[i][k] * b->data[k][j];
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      for (size_t k = 0; k < n; k++) {
+        C[i * ldc + j] += A[i * lda + k] * B[k * ldb + j];
       }
+    }
+  }
 
   double result = omp_get_wtime() - start;
 
@@ -28,16 +36,27 @@ double serial_multiply_ijk(const Matrix *restrict a, const Matrix *restrict b, M
 }
 
 double serial_multiply_ikj(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
   double temp = 0.0;
+  // sizes compiled into MM_FIXED_SIZES get a specialized kernel
+  fixed_kernel fixed = serial_fixed_kernel(n);
   matrix_fill_zero(c);
 
   double start = omp_get_wtime();
 
-  for (int i = 0; i < a->size; i++) {
-    for (int k = 0; k < a->size; k++) {
-      temp = a->data[i][k];
-      for (int j = 0; j < a->size; j++) {
-        c->data[i][j] += temp * b->data[k][j];
+  if (fixed != NULL) {
+    fixed(A, lda, B, ldb, C, ldc);
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      for (size_t k = 0; k < n; k++) {
+        temp = A[i * lda + k];
+        for (size_t j = 0; j < n; j++) {
+          C[i * ldc + j] += temp * B[k * ldb + j];
+        }
       }
     }
   }
@@ -53,14 +72,19 @@ double serial_multiply_ikj(const Matrix *restrict a, const Matrix *restrict b, M
 }
 
 double serial_multiply_jik(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
   matrix_fill_zero(c);
 
   double start = omp_get_wtime();
 
-  for (int j = 0; j < a->size; j++) {
-    for (int i = 0; i < a->size; i++) {
-      for (int k = 0; k < a->size; k++) {
-        c->data[i][j] += a->data[i][k] * b->data[k][j];
+  for (size_t j = 0; j < n; j++) {
+    for (size_t i = 0; i < n; i++) {
+      for (size_t k = 0; k < n; k++) {
+        C[i * ldc + j] += A[i * lda + k] * B[k * ldb + j];
       }
     }
   }
@@ -76,16 +100,21 @@ double serial_multiply_jik(const Matrix *restrict a, const Matrix *restrict b, M
 }
 
 double serial_multiply_jki(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
   double temp = 0.0;
   matrix_fill_zero(c);
 
   double start = omp_get_wtime();
 
-  for (int j = 0; j < a->size; j++) {
-    for (int k = 0; k < a->size; k++) {
-      temp = b->data[k][j];
-      for (int i = 0; i < a->size; i++) {
-        c->data[i][j] += a->data[i][k] * temp;
+  for (size_t j = 0; j < n; j++) {
+    for (size_t k = 0; k < n; k++) {
+      temp = B[k * ldb + j];
+      for (size_t i = 0; i < n; i++) {
+        C[i * ldc + j] += A[i * lda + k] * temp;
       }
     }
   }
@@ -101,16 +130,21 @@ double serial_multiply_jki(const Matrix *restrict a, const Matrix *restrict b, M
 }
 
 double serial_multiply_kij(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
   double temp = 0.0;
   matrix_fill_zero(c);
 
   double start = omp_get_wtime();
 
-  for (int k = 0; k < a->size; k++) {
-    for (int i = 0; i < a->size; i++) {
-      temp = a->data[i][k];
-      for (int j = 0; j < a->size; j++) {
-        c->data[i][j] += temp * b->data[k][j];
+  for (size_t k = 0; k < n; k++) {
+    for (size_t i = 0; i < n; i++) {
+      temp = A[i * lda + k];
+      for (size_t j = 0; j < n; j++) {
+        C[i * ldc + j] += temp * B[k * ldb + j];
       }
     }
   }
@@ -126,16 +160,21 @@ double serial_multiply_kij(const Matrix *restrict a, const Matrix *restrict b, M
 }
 
 double serial_multiply_kji(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
   double temp = 0.0;
   matrix_fill_zero(c);
 
   double start = omp_get_wtime();
 
-  for (int k = 0; k < a->size; k++) {
-    for (int j = 0; j < a->size; j++) {
-      temp = b->data[k][j];
-      for (int i = 0; i < a->size; i++) {
-        c->data[i][j] += a->data[i][k] * temp;
+  for (size_t k = 0; k < n; k++) {
+    for (size_t j = 0; j < n; j++) {
+      temp = B[k * ldb + j];
+      for (size_t i = 0; i < n; i++) {
+        C[i * ldc + j] += A[i * lda + k] * temp;
       }
     }
   }
@@ -0,0 +1,40 @@
+#include "mm_serial_fixed.h"
+
+// meson passes -DMM_FIXED_SIZES(X)=X(4) X(8) ... from the 'fixed_sizes' option
+#ifndef MM_FIXED_SIZES
+#define MM_FIXED_SIZES(X) X(4) X(8) X(16) X(32) X(64)
+#endif
+
+// the k and j loops have constant trip counts and are fully unrolled; the row
+// of C is accumulated in registers and stored once
+#define FIXED_KERNEL(N)                                                        \
+  static void serial_multiply_ikj_##N(const double *restrict A, size_t lda,    \
+                                      const double *restrict B, size_t ldb,    \
+                                      double *restrict C, size_t ldc) {        \
+    for (size_t i = 0; i < N; i++) {                                           \
+      double row[N] = {0.0};                                                   \
+      _Pragma("GCC unroll 64") for (size_t k = 0; k < N; k++) {                \
+        const double temp = A[i * lda + k];                                    \
+        _Pragma("GCC unroll 64") for (size_t j = 0; j < N; j++) {              \
+          row[j] += temp * B[k * ldb + j];                                     \
+        }                                                                      \
+      }                                                                        \
+      for (size_t j = 0; j < N; j++) {                                         \
+        C[i * ldc + j] = row[j];                                               \
+      }                                                                        \
+    }                                                                          \
+  }
+
+MM_FIXED_SIZES(FIXED_KERNEL)
+
+fixed_kernel serial_fixed_kernel(size_t n) {
+  switch (n) {
+#define FIXED_CASE(N)                                                          \
+  case N:                                                                      \
+    return serial_multiply_ikj_##N;
+    MM_FIXED_SIZES(FIXED_CASE)
+#undef FIXED_CASE
+  default:
+    return NULL;
+  }
+}
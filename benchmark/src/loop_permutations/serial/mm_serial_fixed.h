@@ -0,0 +1,16 @@
+// ABOUTME: Serial i-k-j kernels specialized at compile time for fixed small matrix sizes, also used by the batched APIs
+// ABOUTME: The size list is the MM_FIXED_SIZES X-macro, generated from the meson 'fixed_sizes' option
+
+#ifndef MM_SERIAL_FIXED_H
+#define MM_SERIAL_FIXED_H
+
+#include <stddef.h>
+
+typedef void (*fixed_kernel)(const double *restrict A, size_t lda, const double *restrict B, size_t ldb,
+                             double *restrict C, size_t ldc);
+
+// n x n x n kernel with constant, fully unrolled inner loops, or NULL when n
+// is not one of the compiled sizes
+fixed_kernel serial_fixed_kernel(size_t n);
+
+#endif // MM_SERIAL_FIXED_H
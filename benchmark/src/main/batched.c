@@ -0,0 +1,39 @@
+#include "../benchmark/benchmark.h"
+#include "../utils/utils.h"
+#include "parameters.h"
+
+void benchmark_batched(int matrix_size, size_t batch_count, int thread_count) {
+  FILE *csv_file = open_csv_file(csv_batched);
+  if (csv_file == NULL) {
+    perror(csv_batched.filename);
+    exit(1);
+  }
+
+  double time_results[BATCHED_TESTS] = {0};
+  double speedup_results[BATCHED_TESTS] = {0};
+  test_batched(time_results, matrix_size, batch_count, thread_count);
+  compute_speedup(time_results, speedup_results, BATCHED_TESTS);
+
+  fprintf(csv_file, "%d,%zu,%d,%f,%f,%f,%f\n", matrix_size, batch_count,
+          thread_count, speedup_results[0], speedup_results[1],
+          speedup_results[2], speedup_results[3]);
+
+  fclose(csv_file);
+}
+
+int main(int argc, char *argv[]) {
+  // Set output folder if provided as command line argument
+  const char *folder_name = (argc > 1) ? argv[1] : NULL;
+  set_output_folder(folder_name);
+
+  int matrix_sizes[] = BATCH_MATRIX_SIZES;
+  int thread_count = THREAD_COUNT;
+
+  int num_matrix_sizes = sizeof(matrix_sizes) / sizeof(matrix_sizes[0]);
+
+  for (int i = 0; i < num_matrix_sizes; i++) {
+    benchmark_batched(matrix_sizes[i], BATCH_COUNT, thread_count);
+  }
+
+  return 0;
+}
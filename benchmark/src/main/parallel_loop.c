@@ -23,38 +23,47 @@ void benchmark_parallel_loop_permutations(const Matrix *restrict a,
   fclose(csv_file);
 }
 
-void run_benchmark(int matrix_size, int thread_count, int chunk_size) {
+// one input pair per matrix size, shared by all chunk sizes
+void run_benchmark(const BenchmarkArgs *args, int matrix_size, int thread_count,
+                   const int chunk_sizes[], int num_chunk_sizes) {
   Matrix a, b;
-  matrix_create(&a, matrix_size);
-  matrix_create(&b, matrix_size);
-  matrix_fill_random(&a);
-  matrix_fill_random(&b);
+  benchmark_inputs(args, matrix_size, &a, &b);
 
-  benchmark_parallel_loop_permutations(&a, &b, thread_count, chunk_size);
+  for (int j = 0; j < num_chunk_sizes; j++) {
+    benchmark_parallel_loop_permutations(&a, &b, thread_count, chunk_sizes[j]);
+  }
 
   matrix_destroy(&a);
   matrix_destroy(&b);
 }
 
 int main(int argc, char *argv[]) {
-  // Set output folder if provided as command line argument
-  const char *folder_name = (argc > 1) ? argv[1] : NULL;
-  set_output_folder(folder_name);
+  // Output folder and input/output matrix files from the command line
+  BenchmarkArgs args;
+  get_benchmark_args(argc, argv, &args);
+  set_output_folder(args.output_folder);
+  set_validation_mode(args.validation, args.freivalds_trials);
+  set_timing_policy(&args.timing);
+  set_kernel_metrics(args.counters, THREAD_COUNT);
 
   int matrix_sizes[] = MATRIX_SIZES;
   int chunk_sizes[] = CHUNK_SIZES;
   int thread_count = THREAD_COUNT;
 
   int num_matrix_sizes = sizeof(matrix_sizes) / sizeof(matrix_sizes[0]);
+  if (args.a_path != NULL) {
+    // a single run on the matrices read from the input files
+    num_matrix_sizes = 1;
+  }
   int num_chunk_sizes = sizeof(chunk_sizes) / sizeof(chunk_sizes[0]);
 
   for (int i = 0; i < num_matrix_sizes; i++) {
-    for (int j = 0; j < num_chunk_sizes; j++) {
-      int matrix_size = matrix_sizes[i];
-      int chunk_size = chunk_sizes[j];
-      run_benchmark(matrix_size, thread_count, chunk_size);
-    }
+    int matrix_size = matrix_sizes[i];
+    run_benchmark(&args, matrix_size, thread_count, chunk_sizes,
+                  num_chunk_sizes);
   }
 
+  benchmark_write_product(&args, thread_count);
+
   return 0;
 }
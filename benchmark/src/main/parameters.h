@@ -14,12 +14,37 @@
 #define MATRIX_SIZES {480, 640, 960, 1280, 1920}
 #define THREAD_COUNT 10
 #define CHUNK_SIZES {48, 96, 192}
-#define BLOCK_SIZES {48, 96, 128}
+// block size 0 (BLOCK_SIZE_AUTO) uses the mc/kc/nc derived from the host caches
+#define BLOCK_SIZES {0, 48, 96, 128}
+// sparse benchmark: banded inputs with bandwidth MATRIX_SIZE / divisor
+#define SPARSE_BANDWIDTH_DIVISOR 8
+// batched benchmark: BATCH_COUNT products per size
+#define BATCH_MATRIX_SIZES {8, 16, 24, 32, 64}
+#define BATCH_COUNT 1024
+
+// streaming (out-of-core) benchmark: A, B and C live in files under
+// STREAMING_DIRECTORY and at most STREAMING_MEMORY_BUDGET_MB of them is mapped.
+// Sizes, budget and directory are only defaults: --sizes, --budget-mb and
+// --directory override them at runtime
+#define STREAMING_MATRIX_SIZES {2048, 4096}
+#define STREAMING_MEMORY_BUDGET_MB 64
+#define STREAMING_DIRECTORY "/tmp"
+#define STREAMING_SAMPLES 16
+
+// timing of every kernel: WARMUP_RUNS untimed runs, then at least REPETITIONS
+// and at most MAX_REPETITIONS measured runs, stopping once the 95% confidence
+// interval of the mean is within TARGET_CI of it (0 stops at REPETITIONS)
+#define WARMUP_RUNS 1
+#define REPETITIONS 3
+#define MAX_REPETITIONS 10
+#define TARGET_CI 0.05
 
 // number of tests for each benchmark
 #define CLASSIC_VS_IMPROVED_TESTS 4
 #define LOOP_PERMUTATIONS 6
-#define TILED_TESTS 5
+#define TILED_TESTS 13
+#define BATCHED_TESTS 4
+#define SPARSE_TESTS 4
 
 // test colors
 #define GREEN "\033[0;32m"
@@ -28,5 +53,9 @@
 
 // threshold value for validation
 #define EPSILON 1e-6
+// Freivalds validation: default number of trials and the multiple of the
+// sqrt(n) * DBL_EPSILON rounding estimate a row may differ by
+#define FREIVALDS_TRIALS 2
+#define FREIVALDS_TOLERANCE 4.0
 
 #endif // PARAMETERS_H
@@ -1,14 +1,18 @@
 #include "../benchmark/benchmark.h"
+#include "../loop_permutations/serial/mm_serial.h"
 #include "../utils/utils.h"
 #include "parameters.h"
 
-typedef void (*test_function_t)(double time_results[], const Matrix *restrict a,
+typedef void (*test_function_t)(double time_results[],
+                                ReferenceCache *reference,
+                                const Matrix *restrict a,
                                 const Matrix *restrict b, int chunk);
 
 void benchmark_serial_parallel_scaling(const Matrix *restrict a,
                                        const Matrix *restrict b, int chunk,
                                        CSV_DATA csv_data,
-                                       test_function_t test_function) {
+                                       test_function_t test_function,
+                                       ReferenceCache *reference) {
   FILE *csv_file = open_csv_file(csv_data);
   if (csv_file == NULL) {
     perror(csv_data.filename);
@@ -17,51 +21,70 @@ void benchmark_serial_parallel_scaling(const Matrix *restrict a,
 
   double time_results[CLASSIC_VS_IMPROVED_TESTS] = {0};
   double speedup_results[CLASSIC_VS_IMPROVED_TESTS] = {0};
-  test_function(time_results, a, b, chunk);
+  test_function(time_results, reference, a, b, chunk);
   compute_speedup(time_results, speedup_results, CLASSIC_VS_IMPROVED_TESTS);
 
-  fprintf(csv_file, "%d,%d,%f,%f,%f,%f\n", a->size, chunk, speedup_results[0],
-          speedup_results[1], speedup_results[2], speedup_results[3]);
+  fprintf(csv_file, "%d,%d,%f,%f,%f,%f,%d\n", a->size, chunk,
+          speedup_results[0], speedup_results[1], speedup_results[2],
+          speedup_results[3], reference->cached);
 
   fclose(csv_file);
 }
 
-void run_benchmark(int matrix_size, int chunk_size) {
+// one input pair and one run of each serial baseline per matrix size, shared
+// by all chunk sizes
+void run_benchmark(const BenchmarkArgs *args, int matrix_size,
+                   const int chunk_sizes[], int num_chunk_sizes) {
   Matrix a, b;
-  matrix_create(&a, matrix_size);
-  matrix_create(&b, matrix_size);
-  matrix_fill_random(&a);
-  matrix_fill_random(&b);
+  benchmark_inputs(args, matrix_size, &a, &b);
 
-  benchmark_serial_parallel_scaling(&a, &b, chunk_size,
-                                    csv_serial_parallel_scaling_classic,
-                                    test_serial_parallel_scaling_classic);
-  benchmark_serial_parallel_scaling(&a, &b, chunk_size,
-                                    csv_serial_parallel_scaling_improved,
-                                    test_serial_parallel_scaling_improved);
+  ReferenceCache reference_ijk, reference_ikj;
+  reference_cache_init(&reference_ijk, "serial_ijk", serial_multiply_ijk);
+  reference_cache_init(&reference_ikj, "serial_ikj", serial_multiply_ikj);
+  for (int j = 0; j < num_chunk_sizes; j++) {
+    benchmark_serial_parallel_scaling(&a, &b, chunk_sizes[j],
+                                      csv_serial_parallel_scaling_classic,
+                                      test_serial_parallel_scaling_classic,
+                                      &reference_ijk);
+    benchmark_serial_parallel_scaling(&a, &b, chunk_sizes[j],
+                                      csv_serial_parallel_scaling_improved,
+                                      test_serial_parallel_scaling_improved,
+                                      &reference_ikj);
+  }
+  reference_cache_clear(&reference_ijk);
+  reference_cache_clear(&reference_ikj);
 
   matrix_destroy(&a);
   matrix_destroy(&b);
 }
 
 int main(int argc, char *argv[]) {
-  // Set output folder if provided as command line argument
-  const char *folder_name = (argc > 1) ? argv[1] : NULL;
-  set_output_folder(folder_name);
+  // Output folder and input/output matrix files from the command line
+  BenchmarkArgs args;
+  get_benchmark_args(argc, argv, &args);
+  set_output_folder(args.output_folder);
+  set_validation_mode(args.validation, args.freivalds_trials);
+  set_timing_policy(&args.timing);
+  // the scaling tests run teams of up to 8 threads
+  set_kernel_metrics(args.counters, 8);
+  set_reference_cache_directory(args.reference_cache);
 
   int matrix_sizes[] = MATRIX_SIZES;
   int chunk_sizes[] = CHUNK_SIZES;
 
   int num_matrix_sizes = sizeof(matrix_sizes) / sizeof(matrix_sizes[0]);
+  if (args.a_path != NULL) {
+    // a single run on the matrices read from the input files
+    num_matrix_sizes = 1;
+  }
   int num_chunk_sizes = sizeof(chunk_sizes) / sizeof(chunk_sizes[0]);
 
   for (int i = 0; i < num_matrix_sizes; i++) {
-    for (int j = 0; j < num_chunk_sizes; j++) {
-      int matrix_size = matrix_sizes[i];
-      int chunk_size = chunk_sizes[j];
-      run_benchmark(matrix_size, chunk_size);
-    }
+    int matrix_size = matrix_sizes[i];
+    run_benchmark(&args, matrix_size, chunk_sizes, num_chunk_sizes);
   }
 
+  benchmark_write_product(&args, THREAD_COUNT);
+
   return 0;
 }
@@ -1,8 +1,10 @@
 #include "../benchmark/benchmark.h"
+#include "../loop_permutations/serial/mm_serial.h"
 #include "../utils/utils.h"
 #include "parameters.h"
 
-void benchmark_serial_loop_permutations(const Matrix *restrict a,
+void benchmark_serial_loop_permutations(ReferenceCache *reference,
+                                        const Matrix *restrict a,
                                         const Matrix *restrict b) {
 
   FILE *csv_file = open_csv_file(csv_serial_permutations);
@@ -13,42 +15,53 @@ void benchmark_serial_loop_permutations(const Matrix *restrict a,
 
   double time_results[LOOP_PERMUTATIONS] = {0};
   double speedup_results[LOOP_PERMUTATIONS] = {0};
-  test_serial_loop_permutations(time_results, a, b);
+  test_serial_loop_permutations(time_results, reference, a, b);
   compute_speedup(time_results, speedup_results, LOOP_PERMUTATIONS);
 
-  fprintf(csv_file, "%d,%f,%f,%f,%f,%f,%f\n", a->size, speedup_results[0],
+  fprintf(csv_file, "%d,%f,%f,%f,%f,%f,%f,%d\n", a->size, speedup_results[0],
           speedup_results[1], speedup_results[2], speedup_results[3],
-          speedup_results[4], speedup_results[5]);
+          speedup_results[4], speedup_results[5], reference->cached);
 
   fclose(csv_file);
 }
 
-void run_benchmark(int matrix_size) {
+void run_benchmark(const BenchmarkArgs *args, int matrix_size) {
   Matrix a, b;
-  matrix_create(&a, matrix_size);
-  matrix_create(&b, matrix_size);
-  matrix_fill_random(&a);
-  matrix_fill_random(&b);
+  benchmark_inputs(args, matrix_size, &a, &b);
 
-  benchmark_serial_loop_permutations(&a, &b);
+  ReferenceCache reference;
+  reference_cache_init(&reference, "serial_ijk", serial_multiply_ijk);
+  benchmark_serial_loop_permutations(&reference, &a, &b);
+  reference_cache_clear(&reference);
 
   matrix_destroy(&a);
   matrix_destroy(&b);
 }
 
 int main(int argc, char *argv[]) {
-  // Set output folder if provided as command line argument
-  const char *folder_name = (argc > 1) ? argv[1] : NULL;
-  set_output_folder(folder_name);
+  // Output folder and input/output matrix files from the command line
+  BenchmarkArgs args;
+  get_benchmark_args(argc, argv, &args);
+  set_output_folder(args.output_folder);
+  set_validation_mode(args.validation, args.freivalds_trials);
+  set_timing_policy(&args.timing);
+  set_kernel_metrics(args.counters, 1);
+  set_reference_cache_directory(args.reference_cache);
 
   int matrix_sizes[] = MATRIX_SIZES;
 
   int num_matrix_sizes = sizeof(matrix_sizes) / sizeof(matrix_sizes[0]);
+  if (args.a_path != NULL) {
+    // a single run on the matrices read from the input files
+    num_matrix_sizes = 1;
+  }
 
   for (int i = 0; i < num_matrix_sizes; i++) {
     int matrix_size = matrix_sizes[i];
-    run_benchmark(matrix_size);
+    run_benchmark(&args, matrix_size);
   }
 
+  benchmark_write_product(&args, THREAD_COUNT);
+
   return 0;
 }
@@ -0,0 +1,90 @@
+#include "../streaming/mm_streaming.h"
+#include "../utils/utils.h"
+#include "parameters.h"
+#include <limits.h>
+#include <unistd.h>
+
+static void streaming_path(char *path, const char *directory,
+                           const char *name) {
+  if (snprintf(path, PATH_MAX, "%s/%s", directory, name) >= PATH_MAX) {
+    printf("Error: Path too long: %s/%s\n", directory, name);
+    exit(1);
+  }
+}
+
+void benchmark_streaming(const StreamingArgs *args, size_t matrix_size) {
+  FILE *csv_file = open_csv_file(csv_streaming);
+  if (csv_file == NULL) {
+    perror(csv_streaming.filename);
+    exit(1);
+  }
+
+  const size_t budget = args->budget_mb * 1024 * 1024;
+  char scratch_a[PATH_MAX];
+  char scratch_b[PATH_MAX];
+  char scratch_c[PATH_MAX];
+  const char *path_a = args->a_path;
+  const char *path_b = args->b_path;
+  const char *path_c = args->c_path;
+
+  // generated inputs and the product go to the scratch directory unless the
+  // caller named the files
+  const int generated = path_a == NULL;
+  if (generated) {
+    streaming_path(scratch_a, args->directory, "streaming_a.mat");
+    streaming_path(scratch_b, args->directory, "streaming_b.mat");
+    path_a = scratch_a;
+    path_b = scratch_b;
+    streaming_create_random(path_a, matrix_size, budget);
+    streaming_create_random(path_b, matrix_size, budget);
+  }
+  if (path_c == NULL) {
+    streaming_path(scratch_c, args->directory, "streaming_c.mat");
+    path_c = scratch_c;
+  }
+
+  size_t panel_rows = 0;
+  double time = streaming_multiply(path_a, path_b, path_c, matrix_size, budget,
+                                   args->thread_count, &panel_rows);
+  double error = streaming_sample_error(path_a, path_b, path_c, matrix_size,
+                                        STREAMING_SAMPLES);
+  double n = (double)matrix_size;
+  double gflops = 2.0 * n * n * n / time * 1e-9;
+
+#ifdef DEBUG
+  printf("Streaming - matrix size: %zu, threads: %d, budget: %zu MiB, panel "
+         "rows: %zu - time: %f, GFLOP/s: %f, max sample error: %e\n",
+         matrix_size, args->thread_count, args->budget_mb, panel_rows, time,
+         gflops, error);
+#endif
+
+  fprintf(csv_file, "%zu,%d,%zu,%zu,%f,%f,%e\n", matrix_size,
+          args->thread_count, args->budget_mb, panel_rows, time, gflops, error);
+
+  if (generated) {
+    unlink(path_a);
+    unlink(path_b);
+  }
+  if (args->c_path == NULL) {
+    unlink(path_c);
+  }
+  fclose(csv_file);
+}
+
+int main(int argc, char *argv[]) {
+  StreamingArgs args;
+  get_streaming_args(argc, argv, &args);
+  set_output_folder(args.output_folder);
+
+  if (args.a_path != NULL) {
+    const size_t matrix_size = streaming_matrix_size(args.a_path);
+    benchmark_streaming(&args, matrix_size);
+    return 0;
+  }
+
+  for (int i = 0; i < args.size_count; i++) {
+    benchmark_streaming(&args, args.sizes[i]);
+  }
+
+  return 0;
+}
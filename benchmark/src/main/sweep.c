@@ -0,0 +1,14 @@
+#include "../sweep/sweep.h"
+#include "../utils/utils.h"
+
+int main(int argc, char *argv[]) {
+  // kernels, shapes, thread counts, chunk/block sizes and timing from the
+  // command line and config files
+  SweepConfig config;
+  sweep_parse_args(argc, argv, &config);
+  set_output_folder(config.output_folder);
+
+  sweep_run(&config);
+
+  return 0;
+}
@@ -1,9 +1,14 @@
 #include "../benchmark/benchmark.h"
+#include "../gemm/blocking.h"
+#include "../gemm/microkernel.h"
+#include "../loop_permutations/serial/mm_serial.h"
+#include "../strassen/mm_strassen.h"
 #include "../utils/utils.h"
 #include "parameters.h"
 
-void benchmark_tiled(const Matrix *restrict a, const Matrix *restrict b,
-                     int thread_count, int block_size) {
+void benchmark_tiled(ReferenceCache *reference, const Matrix *restrict a,
+                     const Matrix *restrict b, int thread_count,
+                     int block_size) {
   FILE *csv_file = open_csv_file(csv_tiled);
   if (csv_file == NULL) {
     perror(csv_tiled.filename);
@@ -12,48 +17,117 @@ void benchmark_tiled(const Matrix *restrict a, const Matrix *restrict b,
 
   double time_results[TILED_TESTS] = {0};
   double speedup_results[TILED_TESTS] = {0};
-  test_tiled(time_results, a, b, thread_count, block_size);
+  double gflops_results[TILED_TESTS] = {0};
+  TiledReport report = {0};
+  test_tiled(time_results, &report, reference, a, b, thread_count,
+             block_size);
   compute_speedup(time_results, speedup_results, TILED_TESTS);
+  compute_gflops(time_results, gflops_results, TILED_TESTS, a->size);
 
-  fprintf(csv_file, "%d,%d,%d,%f,%f,%f,%f,%f\n", a->size, thread_count,
-          block_size, speedup_results[0], speedup_results[1],
-          speedup_results[2], speedup_results[3], speedup_results[4]);
+  fprintf(csv_file,
+          "%d,%d,%d,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%s,%f,%e,%f,"
+          "%f,%d\n",
+          a->size, thread_count, block_size, speedup_results[0],
+          speedup_results[1], speedup_results[2], speedup_results[3],
+          speedup_results[4], speedup_results[5], speedup_results[6],
+          speedup_results[7], speedup_results[8], speedup_results[9],
+          speedup_results[10], speedup_results[11], speedup_results[12],
+          gflops_results[5],
+          gflops_results[6], gemm_microkernel()->name, report.strassen_mem_mb,
+          report.strassen_max_error, report.tiled_morton_convert_time,
+          report.recursive_morton_convert_time, reference->cached);
 
   fclose(csv_file);
 }
 
-void run_benchmark(int matrix_size, int thread_count, int block_size) {
+void benchmark_sparse(const Matrix *restrict a, const Matrix *restrict b,
+                      int thread_count, int block_size, int bandwidth) {
+  FILE *csv_file = open_csv_file(csv_sparse);
+  if (csv_file == NULL) {
+    perror(csv_sparse.filename);
+    exit(1);
+  }
+
+  double time_results[SPARSE_TESTS] = {0};
+  double speedup_results[SPARSE_TESTS] = {0};
+  size_t skipped_results[2] = {0};
+  test_sparse(time_results, skipped_results, a, b, thread_count, block_size);
+  compute_speedup(time_results, speedup_results, SPARSE_TESTS);
+
+  fprintf(csv_file, "%d,%d,%d,%d,%f,%f,%f,%f,%zu,%zu\n", a->size,
+          thread_count, block_size, bandwidth, speedup_results[0],
+          speedup_results[1], speedup_results[2], speedup_results[3],
+          skipped_results[0], skipped_results[1]);
+
+  fclose(csv_file);
+}
+
+// one input pair and one serial ikj baseline run per matrix size, shared by
+// all block sizes
+void run_benchmark(const BenchmarkArgs *args, int matrix_size,
+                   int thread_count, const int block_sizes[],
+                   int num_block_sizes) {
   Matrix a, b;
-  matrix_create(&a, matrix_size);
-  matrix_create(&b, matrix_size);
-  matrix_fill_random(&a);
-  matrix_fill_random(&b);
+  benchmark_inputs(args, matrix_size, &a, &b);
+
+  ReferenceCache reference;
+  reference_cache_init(&reference, "serial_ikj", serial_multiply_ikj);
+  for (int j = 0; j < num_block_sizes; j++) {
+    benchmark_tiled(&reference, &a, &b, thread_count, block_sizes[j]);
+  }
+  reference_cache_clear(&reference);
 
-  benchmark_tiled(&a, &b, thread_count, block_size);
+  // the same inputs cut down to a band, for the block-sparse kernels
+  int bandwidth = a.size / SPARSE_BANDWIDTH_DIVISOR;
+  matrix_keep_band(&a, bandwidth);
+  matrix_keep_band(&b, bandwidth);
+  for (int j = 0; j < num_block_sizes; j++) {
+    benchmark_sparse(&a, &b, thread_count, block_sizes[j], bandwidth);
+  }
 
   matrix_destroy(&a);
   matrix_destroy(&b);
 }
 
 int main(int argc, char *argv[]) {
-  // Set output folder if provided as command line argument
-  const char *folder_name = (argc > 1) ? argv[1] : NULL;
-  set_output_folder(folder_name);
+  // Output folder and input/output matrix files from the command line
+  BenchmarkArgs args;
+  get_benchmark_args(argc, argv, &args);
+  set_output_folder(args.output_folder);
+  set_validation_mode(args.validation, args.freivalds_trials);
+  set_timing_policy(&args.timing);
+  set_kernel_metrics(args.counters, THREAD_COUNT);
+  set_reference_cache_directory(args.reference_cache);
+
+#ifdef DEBUG
+  const CacheSizes *caches = host_cache_sizes();
+  const GemmBlocking *blocking = gemm_host_blocking();
+  printf("GEMM micro-kernel: %s\n", gemm_microkernel()->name);
+  printf("Caches: L1d %zu KiB, L2 %zu KiB, L3 %zu KiB - host blocking: mr %zu, "
+         "nr %zu, mc %zu, kc %zu, nc %zu\n",
+         caches->l1d / 1024, caches->l2 / 1024, caches->l3 / 1024,
+         blocking->mr, blocking->nr, blocking->mc, blocking->kc, blocking->nc);
+  printf("Strassen cutoff: %d\n", strassen_tuned_cutoff());
+#endif
 
   int matrix_sizes[] = MATRIX_SIZES;
   int block_sizes[] = BLOCK_SIZES;
   int thread_count = THREAD_COUNT;
 
   int num_matrix_sizes = sizeof(matrix_sizes) / sizeof(matrix_sizes[0]);
+  if (args.a_path != NULL) {
+    // a single run on the matrices read from the input files
+    num_matrix_sizes = 1;
+  }
   int num_block_sizes = sizeof(block_sizes) / sizeof(block_sizes[0]);
 
   for (int i = 0; i < num_matrix_sizes; i++) {
-    for (int j = 0; j < num_block_sizes; j++) {
-      int matrix_size = matrix_sizes[i];
-      int block_size = block_sizes[j];
-      run_benchmark(matrix_size, thread_count, block_size);
-    }
+    int matrix_size = matrix_sizes[i];
+    run_benchmark(&args, matrix_size, thread_count, block_sizes,
+                  num_block_sizes);
   }
 
+  benchmark_write_product(&args, thread_count);
+
   return 0;
 }
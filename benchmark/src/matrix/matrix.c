@@ -1,73 +1,378 @@
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+
 #include "matrix.h"
 #include "../main/parameters.h"
+#include <fcntl.h>
+#include <float.h>
 #include <math.h>
 #include <omp.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+size_t matrix_padded_ld(size_t size) {
+  const size_t per_line = MATRIX_ALIGNMENT / sizeof(double);
+  return (size + per_line - 1) / per_line * per_line;
+}
 
 void matrix_create(Matrix *matrix, int size) {
-  matrix->data = (double **)malloc(size * sizeof(double *));
-  if (matrix->data == NULL) {
+  size_t ld = matrix_padded_ld((size_t)size);
+  size_t bytes = ld * (size_t)size * sizeof(double);
+  void *data = NULL;
+
+  if (bytes == 0) {
+    bytes = MATRIX_ALIGNMENT;
+  }
+  if (posix_memalign(&data, MATRIX_ALIGNMENT, bytes) != 0) {
     printf("Error: Failed to allocate memory for matrix\n");
     exit(1);
   }
-#pragma omp parallel for
-  for (int i = 0; i < size; i++) {
-    matrix->data[i] = (double *)malloc(size * sizeof(double));
-    if (matrix->data[i] == NULL) {
-      printf("Error: Failed to allocate memory for matrix\n");
-      exit(1);
-    }
-  }
+  matrix->data = (double *)data;
   matrix->size = size;
+  matrix->ld = ld;
+  matrix->mapped_bytes = 0;
+}
+
+size_t matrix_create_batch(Matrix *matrices, int size, size_t count) {
+  // whole padded rows per item keep every item aligned
+  const size_t ld = matrix_padded_ld((size_t)size);
+  const size_t stride = ld * (size_t)size;
+  void *data = NULL;
+  size_t bytes = stride * count * sizeof(double);
+  if (posix_memalign(&data, MATRIX_ALIGNMENT, bytes > 0 ? bytes : MATRIX_ALIGNMENT) != 0) {
+    printf("Error: Failed to allocate memory for matrix batch\n");
+    exit(1);
+  }
+  for (size_t b = 0; b < count; b++) {
+    matrices[b].data = (double *)data + b * stride;
+    matrices[b].size = size;
+    matrices[b].ld = ld;
+    matrices[b].mapped_bytes = 0;
+  }
+  return stride;
+}
+
+void matrix_destroy_batch(Matrix *matrices) {
+  free(matrices[0].data);
+  matrices[0].data = NULL;
 }
 
 void matrix_fill_zero(Matrix *restrict matrix) {
+  const size_t n = (size_t)matrix->size;
+  const size_t ld = matrix->ld;
+  double *restrict data = matrix->data;
 #pragma omp parallel for
-  for (int i = 0; i < matrix->size; i++) {
-    for (int j = 0; j < matrix->size; j++) {
-      matrix->data[i][j] = 0;
+  for (size_t i = 0; i < n; i++) {
+    memset(&data[i * ld], 0, ld * sizeof(double));
+  }
+}
+
+static uint64_t random_seed;
+static int random_seeded = 0;
+
+void matrix_set_random_seed(uint64_t seed) {
+#pragma omp critical(matrix_random_seed)
+  {
+    random_seed = seed;
+    random_seeded = 1;
+  }
+}
+
+uint64_t matrix_random_seed(void) {
+  uint64_t seed;
+#pragma omp critical(matrix_random_seed)
+  {
+    if (!random_seeded) {
+      random_seed = (uint64_t)SEED;
+      random_seeded = 1;
     }
+    seed = random_seed;
   }
+  return seed;
+}
+
+uint64_t matrix_random_stream(void) {
+  static uint64_t streams = 0;
+  uint64_t stream;
+#pragma omp atomic capture
+  stream = streams++;
+  return matrix_random_bits(matrix_random_seed(), stream);
 }
 
 void matrix_fill_random(Matrix *restrict matrix) {
-#pragma omp parallel
-  {
-    unsigned int seed = SEED + omp_get_thread_num();
-#pragma omp for
-    for (int i = 0; i < matrix->size; i++) {
-      for (int j = 0; j < matrix->size; j++) {
-        matrix->data[i][j] = UNIFORM_MIN + (UNIFORM_MAX - UNIFORM_MIN) *
-                                               (double)rand_r(&seed) /
-                                               (double)RAND_MAX;
+  matrix_fill_random_key(matrix, matrix_random_stream());
+}
+
+void matrix_fill_random_key(Matrix *restrict matrix, uint64_t key) {
+  const size_t n = (size_t)matrix->size;
+  const size_t ld = matrix->ld;
+  double *restrict data = matrix->data;
+#pragma omp parallel for default(none) shared(data, n, ld, key)
+  for (size_t i = 0; i < n; i++) {
+    double *restrict row = &data[i * ld];
+    const uint64_t first = (uint64_t)(i * n);
+#pragma omp simd
+    for (size_t j = 0; j < n; j++) {
+      row[j] = UNIFORM_MIN + (UNIFORM_MAX - UNIFORM_MIN) *
+                                 matrix_random_unit(key, first + j);
+    }
+  }
+}
+
+void matrix_keep_band(Matrix *restrict matrix, int bandwidth) {
+  const size_t n = (size_t)matrix->size;
+  const size_t ld = matrix->ld;
+  const size_t band = (size_t)bandwidth;
+  double *restrict data = matrix->data;
+#pragma omp parallel for
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      if ((i > j ? i - j : j - i) > band) {
+        data[i * ld + j] = 0.0;
       }
     }
   }
 }
 
+void matrix_file_header(MatrixFileHeader *header, size_t size, size_t ld) {
+  memset(header, 0, sizeof(*header));
+  memcpy(header->magic, MATRIX_FILE_MAGIC, sizeof(header->magic));
+  header->dtype = MATRIX_DTYPE_FLOAT64;
+  header->header_bytes = MATRIX_FILE_HEADER_BYTES;
+  header->rows = size;
+  header->cols = size;
+  header->ld = ld;
+}
+
+size_t matrix_file_read_header(int fd, const char *path,
+                               MatrixFileHeader *header) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    printf("Error: Failed to open %s\n", path);
+    exit(1);
+  }
+
+  if ((size_t)st.st_size < sizeof(*header) ||
+      pread(fd, header, sizeof(*header), 0) != (ssize_t)sizeof(*header) ||
+      memcmp(header->magic, MATRIX_FILE_MAGIC, sizeof(header->magic)) != 0) {
+    printf("Error: %s is not a matrix file\n", path);
+    exit(1);
+  }
+  if (header->dtype != MATRIX_DTYPE_FLOAT64) {
+    printf("Error: %s holds dtype %u, only float64 is supported\n", path,
+           (unsigned)header->dtype);
+    exit(1);
+  }
+  if (header->rows != header->cols || header->ld < header->cols) {
+    printf("Error: %s holds a %llu x %llu matrix with ld %llu, expected a "
+           "square one\n",
+           path, (unsigned long long)header->rows,
+           (unsigned long long)header->cols, (unsigned long long)header->ld);
+    exit(1);
+  }
+
+  if (header->header_bytes < sizeof(*header) ||
+      header->header_bytes > (uint64_t)st.st_size) {
+    printf("Error: %s has an invalid header size %llu\n", path,
+           (unsigned long long)header->header_bytes);
+    exit(1);
+  }
+
+  const size_t size = (size_t)header->rows;
+  const size_t ld = (size_t)header->ld;
+  // a huge ld would wrap the payload size below the file size
+  if (size > 0 &&
+      ld > (SIZE_MAX - header->header_bytes) / sizeof(double) / size) {
+    printf("Error: %s holds an invalid ld %llu\n", path,
+           (unsigned long long)header->ld);
+    exit(1);
+  }
+  const size_t bytes = header->header_bytes + ld * size * sizeof(double);
+  if ((size_t)st.st_size < bytes) {
+    printf("Error: %s is truncated\n", path);
+    exit(1);
+  }
+  return bytes;
+}
+
+void matrix_load(Matrix *matrix, const char *path) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    printf("Error: Failed to open %s\n", path);
+    exit(1);
+  }
+
+  MatrixFileHeader header;
+  const size_t bytes = matrix_file_read_header(fd, path, &header);
+  if (header.rows > INT32_MAX) {
+    printf("Error: %s holds a %llu x %llu matrix, too large to load\n", path,
+           (unsigned long long)header.rows, (unsigned long long)header.cols);
+    exit(1);
+  }
+  const int size = (int)header.rows;
+  const size_t ld = (size_t)header.ld;
+
+  // copy-on-write so that in-place edits (e.g. matrix_keep_band) stay private
+  void *mapping = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    printf("Error: Failed to map %s\n", path);
+    exit(1);
+  }
+  double *payload = (double *)((char *)mapping + header.header_bytes);
+
+  // the mapping is page aligned, so rows are aligned when the offset and the
+  // row pitch are; otherwise repack into an aligned buffer
+  if (header.header_bytes % MATRIX_ALIGNMENT == 0 &&
+      ld * sizeof(double) % MATRIX_ALIGNMENT == 0) {
+    posix_madvise(mapping, bytes, POSIX_MADV_WILLNEED);
+    matrix->data = payload;
+    matrix->size = size;
+    matrix->ld = ld;
+    matrix->mapped_bytes = bytes;
+    return;
+  }
+
+  matrix_create(matrix, size);
+  for (size_t i = 0; i < (size_t)size; i++) {
+    memcpy(&matrix->data[i * matrix->ld], &payload[i * ld],
+           (size_t)size * sizeof(double));
+  }
+  munmap(mapping, bytes);
+}
+
+void matrix_store(const Matrix *restrict matrix, const char *path) {
+  const size_t rows = (size_t)matrix->size;
+  const size_t payload_bytes = rows * matrix->ld * sizeof(double);
+  const size_t bytes = MATRIX_FILE_HEADER_BYTES + payload_bytes;
+
+  int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    printf("Error: Failed to create %s\n", path);
+    exit(1);
+  }
+  if (ftruncate(fd, (off_t)bytes) != 0) {
+    printf("Error: Failed to resize %s to %zu bytes\n", path, bytes);
+    exit(1);
+  }
+  void *mapping = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    printf("Error: Failed to map %s\n", path);
+    exit(1);
+  }
+
+  MatrixFileHeader header;
+  matrix_file_header(&header, rows, matrix->ld);
+  memcpy(mapping, &header, sizeof(header));
+  // row by row, leaving the padding past size as the zeros ftruncate wrote,
+  // so files do not depend on whatever the padding of the buffer held
+  double *payload = (double *)((char *)mapping + MATRIX_FILE_HEADER_BYTES);
+  for (size_t i = 0; i < rows; i++) {
+    memcpy(&payload[i * matrix->ld], &matrix->data[i * matrix->ld],
+           rows * sizeof(double));
+  }
+
+  if (msync(mapping, bytes, MS_SYNC) != 0) {
+    printf("Error: Failed to write %s\n", path);
+    exit(1);
+  }
+  munmap(mapping, bytes);
+}
+
 void matrix_print(const Matrix *restrict matrix) {
   for (int i = 0; i < matrix->size; i++) {
     for (int j = 0; j < matrix->size; j++) {
-      printf("%f ", matrix->data[i][j]);
+      printf("%f ", MATRIX_AT(matrix, i, j));
     }
     printf("\n");
   }
 }
 
 void matrix_destroy(Matrix *restrict matrix) {
-  for (int i = 0; i < matrix->size; i++) {
-    free(matrix->data[i]);
+  if (matrix->mapped_bytes > 0) {
+    // the mapping is the file header followed by the payload data points to
+    const size_t payload_bytes =
+        matrix->ld * (size_t)matrix->size * sizeof(double);
+    munmap((char *)matrix->data - (matrix->mapped_bytes - payload_bytes),
+           matrix->mapped_bytes);
+  } else {
+    free(matrix->data);
   }
-  free(matrix->data);
+  matrix->data = NULL;
 }
 
-int validate(const Matrix *restrict a, const Matrix *restrict b) {
+double matrix_max_error(const Matrix *restrict a, const Matrix *restrict b) {
+  const size_t n = (size_t)a->size;
   double max_diff = 0.0;
 #pragma omp parallel for reduction(max : max_diff)
-  for (int i = 0; i < a->size; i++) {
-    for (int j = 0; j < a->size; j++) {
-      double diff = fabs(a->data[i][j] - b->data[i][j]);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      double diff = fabs(MATRIX_AT(a, i, j) - MATRIX_AT(b, i, j));
       max_diff = (diff > max_diff) ? diff : max_diff;
     }
   }
-  return max_diff <= EPSILON;
+  return max_diff;
+}
+
+int validate(const Matrix *restrict a, const Matrix *restrict b) {
+  return matrix_max_error(a, b) <= EPSILON;
+}
+
+int freivalds_validate(const Matrix *restrict a, const Matrix *restrict b, const Matrix *restrict c,
+                       int trials) {
+  const size_t n = (size_t)a->size;
+  return freivalds_validate_gemm(n, n, n, a->data, a->ld, b->data, b->ld, c->data, c->ld, trials);
+}
+
+int freivalds_validate_gemm(size_t m, size_t n, size_t k, const double *A, size_t lda, const double *B,
+                            size_t ldb, const double *C, size_t ldc, int trials) {
+  // rounding errors of random data grow like sqrt(k) rather than the
+  // worst-case k, which keeps the test sensitive at large sizes
+  const double scale = FREIVALDS_TOLERANCE * sqrt((double)k) * DBL_EPSILON;
+  // r (n), B * r and |B| * |r| (k each)
+  double *vectors = malloc((n + 2 * k + 1) * sizeof(double));
+  if (vectors == NULL) {
+    printf("Error: Failed to allocate memory for Freivalds vectors\n");
+    exit(1);
+  }
+  double *restrict r = vectors, *restrict br = vectors + n, *restrict br_bound = vectors + n + k;
+
+  int correct = 1;
+  for (int trial = 0; trial < trials && correct; trial++) {
+    const uint64_t key = matrix_random_stream();
+    for (size_t j = 0; j < n; j++) {
+      r[j] = 2.0 * matrix_random_unit(key, j) - 1.0;
+    }
+
+#pragma omp parallel for default(none) shared(B, ldb, r, br, br_bound, n, k)
+    for (size_t p = 0; p < k; p++) {
+      double sum = 0.0, bound = 0.0;
+      for (size_t j = 0; j < n; j++) {
+        sum += B[p * ldb + j] * r[j];
+        bound += fabs(B[p * ldb + j]) * fabs(r[j]);
+      }
+      br[p] = sum;
+      br_bound[p] = bound;
+    }
+
+#pragma omp parallel for default(none) shared(A, lda, C, ldc, r, br, br_bound, m, n, k, scale) \
+    reduction(&& : correct)
+    for (size_t i = 0; i < m; i++) {
+      double abr = 0.0, cr = 0.0, bound = 0.0;
+      for (size_t p = 0; p < k; p++) {
+        abr += A[i * lda + p] * br[p];
+        bound += fabs(A[i * lda + p]) * br_bound[p];
+      }
+      for (size_t j = 0; j < n; j++) {
+        cr += C[i * ldc + j] * r[j];
+      }
+      correct = correct && fabs(cr - abr) <= scale * bound;
+    }
+  }
+
+  free(vectors);
+  return correct;
 }
@@ -4,22 +4,123 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
+// alignment (in bytes) of the matrix storage and of every row
+#define MATRIX_ALIGNMENT 64
+
+// row-major storage in a single aligned block: element (i, j) lives at
+// data[i * ld + j], where the leading dimension ld >= size is padded so that
+// every row starts on a MATRIX_ALIGNMENT boundary
 typedef struct {
-  double** data;
+  double* data;
   int size;
+  size_t ld;
+  size_t mapped_bytes; // length of the file mapping holding data, 0 if allocated
 } Matrix;
 
+// binary matrix file: a MATRIX_FILE_HEADER_BYTES header followed by rows
+// of ld elements each, row-major, starting at offset header_bytes. Values are
+// stored in host byte order.
+#define MATRIX_FILE_MAGIC "MATBIN01"
+#define MATRIX_FILE_HEADER_BYTES MATRIX_ALIGNMENT
+#define MATRIX_DTYPE_FLOAT64 1
+
+typedef struct {
+  char magic[8];         // MATRIX_FILE_MAGIC, not NUL terminated
+  uint32_t dtype;        // MATRIX_DTYPE_FLOAT64
+  uint32_t header_bytes; // offset of the first row
+  uint64_t rows;
+  uint64_t cols;
+  uint64_t ld;           // elements between the starts of consecutive rows
+  uint8_t reserved[MATRIX_FILE_HEADER_BYTES - 40];
+} MatrixFileHeader;
+
+#define MATRIX_AT(m, i, j) ((m)->data[(size_t)(i) * (m)->ld + (size_t)(j)])
+
+// counter-based generator (SplitMix64 mixing): element index of the stream
+// with the given key is a pure function of (key, index), so fills come out
+// bit-identical for every thread count and schedule, and vectorize
+static inline uint64_t matrix_random_bits(uint64_t key, uint64_t index) {
+  uint64_t z = key + (index + 1) * 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// uniform in [0, 1): the top 52 bits become the mantissa of a double in [1, 2)
+static inline double matrix_random_unit(uint64_t key, uint64_t index) {
+  union {
+    uint64_t bits;
+    double value;
+  } u;
+  u.bits = 0x3FF0000000000000ULL | (matrix_random_bits(key, index) >> 12);
+  return u.value - 1.0;
+}
+
 typedef double (*serial_loop_benchmark)(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c);
 typedef double (*parallel_loop_benchmark)(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c, int thread_count, int chunk_size);
 
 void matrix_create(Matrix* matrix, int size);
+// count size x size matrices in one aligned block, matrix b starting at
+// matrices[0].data + b * stride; returns the stride in elements
+size_t matrix_create_batch(Matrix *matrices, int size, size_t count);
+void matrix_destroy_batch(Matrix *matrices);
+// the process seed: the one set with matrix_set_random_seed, otherwise SEED,
+// read on the first call
+uint64_t matrix_random_seed(void);
+// replaces SEED, to be called before the first fill
+void matrix_set_random_seed(uint64_t seed);
+// key of a fresh stream: the process seed mixed with the number of streams
+// handed out before, so successive fills differ but a run is reproduced by
+// its seed
+uint64_t matrix_random_stream(void);
+// element (i, j) is UNIFORM_MIN + (UNIFORM_MAX - UNIFORM_MIN) * unit(i * size + j)
+// on a fresh stream
 void matrix_fill_random(Matrix *restrict matrix);
+// the same on the stream with the given key
+void matrix_fill_random_key(Matrix *restrict matrix, uint64_t key);
 void matrix_fill_zero(Matrix *restrict matrix);
+// zeroes every element with |i - j| > bandwidth
+void matrix_keep_band(Matrix *restrict matrix, int bandwidth);
+double matrix_max_error(const Matrix *restrict a, const Matrix *restrict b);
 int validate(const Matrix *restrict a, const Matrix *restrict b);
+
+// how a computed product is checked: against a reference product (max abs
+// difference <= EPSILON) or with Freivalds' randomized test
+typedef enum { VALIDATE_REFERENCE, VALIDATE_FREIVALDS } ValidationMode;
+
+// Freivalds' test of c == a * b in O(n^2) per trial: c * r is compared with
+// a * (b * r) for a random r in [-1, 1)^n. Row i passes when the difference is
+// within FREIVALDS_TOLERANCE * sqrt(n) * DBL_EPSILON * (|a| * (|b| * |r|))_i,
+// the expected rounding error of the two products; a wrong c fails a trial
+// with probability close to 1
+int freivalds_validate(const Matrix *restrict a, const Matrix *restrict b, const Matrix *restrict c,
+                       int trials);
+// the same test of C (m x n) == A (m x k) * B (k x n) on raw row-major buffers
+int freivalds_validate_gemm(size_t m, size_t n, size_t k, const double *A, size_t lda, const double *B,
+                            size_t ldb, const double *C, size_t ldc, int trials);
+// the row pitch of matrix_create: size rounded up to whole MATRIX_ALIGNMENT
+// sized lines
+size_t matrix_padded_ld(size_t size);
+// header of a size x size float64 matrix with rows of ld elements, the
+// payload right after the header
+void matrix_file_header(MatrixFileHeader *header, size_t size, size_t ld);
+// reads the header of the open matrix file and checks it: magic, float64, a
+// square matrix, a header size and ld whose payload fits in the file. Prints
+// an error and exits on a bad file, otherwise returns the bytes of header and
+// payload
+size_t matrix_file_read_header(int fd, const char *path,
+                               MatrixFileHeader *header);
+// maps a binary matrix file copy-on-write: data points into the mapping when
+// the payload is MATRIX_ALIGNMENT aligned, otherwise it is copied into a
+// matrix_create buffer. Writes to the matrix never reach the file.
+void matrix_load(Matrix *matrix, const char *path);
+// writes the matrix, padding included, to a new binary matrix file
+void matrix_store(const Matrix *restrict matrix, const char *path);
 void matrix_print(const Matrix *restrict matrix);
 void matrix_destroy(Matrix *restrict matrix);
 
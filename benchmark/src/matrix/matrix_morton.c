@@ -0,0 +1,88 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "matrix_morton.h"
+#include <string.h>
+
+void morton_create(MortonMatrix *matrix, int size, size_t tile_hint) {
+  const size_t n = (size_t)size;
+  if (tile_hint == 0) {
+    tile_hint = 1;
+  }
+  size_t tiles = 1;
+  while (tiles * tile_hint < n) {
+    tiles *= 2;
+  }
+  // spread the rows over the power-of-two grid instead of padding whole tiles
+  size_t tile = (n + tiles - 1) / tiles;
+  tile = (tile + 7) / 8 * 8;
+  if (tile == 0) {
+    tile = 8;
+  }
+
+  void *data = NULL;
+  if (posix_memalign(&data, MATRIX_ALIGNMENT,
+                     tiles * tiles * tile * tile * sizeof(double)) != 0) {
+    printf("Error: Failed to allocate memory for Morton matrix\n");
+    exit(1);
+  }
+  matrix->data = (double *)data;
+  matrix->size = size;
+  matrix->tile = tile;
+  matrix->tiles = tiles;
+  morton_fill_zero(matrix);
+}
+
+void morton_fill_zero(MortonMatrix *restrict matrix) {
+  const size_t count = matrix->tiles * matrix->tiles;
+  const size_t tile_elems = matrix->tile * matrix->tile;
+  double *restrict data = matrix->data;
+#pragma omp parallel for
+  for (size_t t = 0; t < count; t++) {
+    memset(&data[t * tile_elems], 0, tile_elems * sizeof(double));
+  }
+}
+
+void matrix_to_morton(const Matrix *restrict src, MortonMatrix *restrict dst) {
+  const size_t n = (size_t)src->size;
+  const size_t tile = dst->tile, used = MORTON_USED_TILES(dst);
+  const size_t ld = src->ld;
+  const double *restrict S = src->data;
+#pragma omp parallel for collapse(2)
+  for (size_t ti = 0; ti < used; ti++) {
+    for (size_t tj = 0; tj < used; tj++) {
+      double *restrict T = MORTON_TILE(dst, ti, tj);
+      size_t rows = (ti * tile + tile > n) ? n - ti * tile : tile;
+      size_t cols = (tj * tile + tile > n) ? n - tj * tile : tile;
+      for (size_t i = 0; i < rows; i++) {
+        memcpy(&T[i * tile], &S[(ti * tile + i) * ld + tj * tile],
+               cols * sizeof(double));
+        memset(&T[i * tile + cols], 0, (tile - cols) * sizeof(double));
+      }
+      memset(&T[rows * tile], 0, (tile - rows) * tile * sizeof(double));
+    }
+  }
+}
+
+void morton_to_matrix(const MortonMatrix *restrict src, Matrix *restrict dst) {
+  const size_t n = (size_t)dst->size;
+  const size_t tile = src->tile, used = MORTON_USED_TILES(src);
+  const size_t ld = dst->ld;
+  double *restrict D = dst->data;
+#pragma omp parallel for collapse(2)
+  for (size_t ti = 0; ti < used; ti++) {
+    for (size_t tj = 0; tj < used; tj++) {
+      const double *restrict T = MORTON_TILE(src, ti, tj);
+      size_t rows = (ti * tile + tile > n) ? n - ti * tile : tile;
+      size_t cols = (tj * tile + tile > n) ? n - tj * tile : tile;
+      for (size_t i = 0; i < rows; i++) {
+        memcpy(&D[(ti * tile + i) * ld + tj * tile], &T[i * tile],
+               cols * sizeof(double));
+      }
+    }
+  }
+}
+
+void morton_destroy(MortonMatrix *restrict matrix) {
+  free(matrix->data);
+  matrix->data = NULL;
+}
@@ -0,0 +1,48 @@
+// ABOUTME: Z-order (Morton) tiled storage for square matrices and conversion to/from row-major
+// ABOUTME: Every tile is one contiguous row-major chunk; tiles are laid out along a Z curve
+
+#ifndef MATRIX_MORTON_H
+#define MATRIX_MORTON_H
+
+#include "matrix.h"
+
+// The matrix is cut into a tiles x tiles grid of tile x tile blocks, with
+// tiles a power of two. Tile (ti, tj) starts at data[morton_index(ti, tj) *
+// tile * tile], so each quadrant of the grid (and recursively each of its
+// quadrants) is contiguous. Elements past size are zero padding
+typedef struct {
+  double *data;
+  int size;
+  size_t tile;
+  size_t tiles;
+} MortonMatrix;
+
+// interleaves the bits of ti (odd positions) and tj (even positions), so the
+// quadrants of any aligned 2^l x 2^l block of tiles come in the order
+// top-left, top-right, bottom-left, bottom-right
+static inline size_t morton_index(size_t ti, size_t tj) {
+  size_t index = 0;
+  for (size_t bit = 0; (ti >> bit) != 0 || (tj >> bit) != 0; bit++) {
+    index |= ((ti >> bit) & 1) << (2 * bit + 1);
+    index |= ((tj >> bit) & 1) << (2 * bit);
+  }
+  return index;
+}
+
+#define MORTON_TILE(m, ti, tj) ((m)->data + morton_index((ti), (tj)) * (m)->tile * (m)->tile)
+
+typedef double (*morton_benchmark)(const MortonMatrix *restrict a, const MortonMatrix *restrict b,
+                                   MortonMatrix *restrict c, int thread_count);
+
+// tiles used by the matrix itself, the rest of the grid is padding
+#define MORTON_USED_TILES(m) (((size_t)(m)->size + (m)->tile - 1) / (m)->tile)
+
+// the tile is tile_hint rounded so that the grid side is a power of two and
+// the tile a multiple of 8 wide
+void morton_create(MortonMatrix *matrix, int size, size_t tile_hint);
+void morton_fill_zero(MortonMatrix *restrict matrix);
+void matrix_to_morton(const Matrix *restrict src, MortonMatrix *restrict dst);
+void morton_to_matrix(const MortonMatrix *restrict src, Matrix *restrict dst);
+void morton_destroy(MortonMatrix *restrict matrix);
+
+#endif // MATRIX_MORTON_H
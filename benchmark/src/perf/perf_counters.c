@@ -0,0 +1,246 @@
+#define _DEFAULT_SOURCE
+
+#include "perf_counters.h"
+#include <math.h>
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+const char *const perf_metric_names[PERF_METRICS] = {"CYCLES",     "INSTRUCTIONS", "L1D_MISSES",
+                                                     "LLC_MISSES", "DTLB_MISSES",  "FP_OPS"};
+
+#ifdef __linux__
+
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// one hardware event; a metric is the weighted sum of its events
+typedef struct {
+  PerfMetric metric;
+  uint32_t type;
+  uint64_t config;
+  double weight;
+} PerfEvent;
+
+#define HW_CACHE_READ_MISS(cache)                                                                                \
+  ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const PerfEvent generic_events[] = {
+    {PERF_CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 1.0},
+    {PERF_INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 1.0},
+    {PERF_L1D_MISSES, PERF_TYPE_HW_CACHE, HW_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D), 1.0},
+    {PERF_LLC_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, 1.0},
+    {PERF_DTLB_MISSES, PERF_TYPE_HW_CACHE, HW_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB), 1.0},
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+// FP_ARITH_INST_RETIRED (event 0xc7): scalar, 128-, 256- and 512-bit packed
+// double instructions, weighted by their lanes (an FMA already counts twice).
+// There is no generic FP event, and other vendors use different raw codes
+static const PerfEvent intel_fp_events[] = {
+    {PERF_FP_OPS, PERF_TYPE_RAW, 0x01c7, 1.0},
+    {PERF_FP_OPS, PERF_TYPE_RAW, 0x04c7, 2.0},
+    {PERF_FP_OPS, PERF_TYPE_RAW, 0x10c7, 4.0},
+    {PERF_FP_OPS, PERF_TYPE_RAW, 0x40c7, 8.0},
+};
+#endif
+
+#define PERF_MAX_EVENTS 9
+
+typedef struct {
+  uint64_t value;
+  uint64_t enabled;
+  uint64_t running;
+} PerfReading;
+
+static PerfEvent events[PERF_MAX_EVENTS];
+static int event_count = 0;
+static int thread_total = 0;
+static int *fds = NULL;                 // fds[thread * event_count + event], -1 if not open
+static PerfReading *start_reads = NULL; // same layout
+static int metric_available[PERF_METRICS];
+
+// thread ids of the process, from /proc/self/task
+static pid_t *list_threads(int *count) {
+  DIR *dir = opendir("/proc/self/task");
+  if (dir == NULL) {
+    *count = 0;
+    return NULL;
+  }
+  int capacity = 64, total = 0;
+  pid_t *tids = malloc((size_t)capacity * sizeof(pid_t));
+  struct dirent *entry;
+  while (tids != NULL && (entry = readdir(dir)) != NULL) {
+    if (entry->d_name[0] < '0' || entry->d_name[0] > '9') {
+      continue;
+    }
+    if (total == capacity) {
+      capacity *= 2;
+      pid_t *grown = realloc(tids, (size_t)capacity * sizeof(pid_t));
+      if (grown == NULL) {
+        free(tids);
+        tids = NULL;
+        break;
+      }
+      tids = grown;
+    }
+    tids[total++] = (pid_t)atoi(entry->d_name);
+  }
+  closedir(dir);
+  *count = (tids != NULL) ? total : 0;
+  return tids;
+}
+
+static int open_event(const PerfEvent *event, pid_t tid) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event->type;
+  attr.config = event->config;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int)syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0UL);
+}
+
+static int read_event(int fd, PerfReading *reading) {
+  return fd >= 0 && read(fd, reading, sizeof(*reading)) == (ssize_t)sizeof(*reading);
+}
+
+int perf_counters_open(int thread_count) {
+  perf_counters_close();
+
+  // pool threads are created by the first region that needs them; an empty
+  // region would be optimized away
+  int team = 0;
+#pragma omp parallel num_threads(thread_count > 0 ? thread_count : 1) default(none) shared(team)
+  {
+#pragma omp single
+    team = omp_get_num_threads();
+  }
+  (void)team;
+
+  event_count = 0;
+  for (size_t i = 0; i < sizeof(generic_events) / sizeof(generic_events[0]); i++) {
+    events[event_count++] = generic_events[i];
+  }
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_is("intel")) {
+    for (size_t i = 0; i < sizeof(intel_fp_events) / sizeof(intel_fp_events[0]); i++) {
+      events[event_count++] = intel_fp_events[i];
+    }
+  }
+#endif
+
+  pid_t *tids = list_threads(&thread_total);
+  fds = malloc((size_t)(thread_total * event_count) * sizeof(int));
+  start_reads = malloc((size_t)(thread_total * event_count) * sizeof(PerfReading));
+  if (tids == NULL || fds == NULL || start_reads == NULL) {
+    free(tids);
+    perf_counters_close();
+    return 0;
+  }
+
+  // a metric counts only if all of its events open on every thread
+  for (int m = 0; m < PERF_METRICS; m++) {
+    metric_available[m] = 0;
+  }
+  for (int e = 0; e < event_count; e++) {
+    metric_available[events[e].metric] = 1;
+  }
+  for (int t = 0; t < thread_total; t++) {
+    for (int e = 0; e < event_count; e++) {
+      int fd = open_event(&events[e], tids[t]);
+      fds[t * event_count + e] = fd;
+      if (fd < 0) {
+        metric_available[events[e].metric] = 0;
+      }
+    }
+  }
+  free(tids);
+
+  int available = 0;
+  for (int m = 0; m < PERF_METRICS; m++) {
+    available += metric_available[m];
+  }
+  if (available == 0) {
+    perf_counters_close();
+  }
+  return available;
+}
+
+void perf_counters_start(void) {
+  for (int i = 0; i < thread_total * event_count; i++) {
+    if (!read_event(fds[i], &start_reads[i])) {
+      start_reads[i].value = 0;
+      start_reads[i].enabled = 0;
+      start_reads[i].running = 0;
+    }
+  }
+}
+
+void perf_counters_stop(PerfSample *sample) {
+  for (int m = 0; m < PERF_METRICS; m++) {
+    sample->values[m] = metric_available[m] ? 0.0 : NAN;
+  }
+
+  for (int t = 0; t < thread_total; t++) {
+    for (int e = 0; e < event_count; e++) {
+      const int i = t * event_count + e;
+      const PerfMetric metric = events[e].metric;
+      PerfReading end;
+      if (!metric_available[metric] || !read_event(fds[i], &end)) {
+        continue;
+      }
+      const double enabled = (double)(end.enabled - start_reads[i].enabled);
+      const double running = (double)(end.running - start_reads[i].running);
+      if (running > 0.0) {
+        // enabled / running extrapolates events that were multiplexed with others
+        sample->values[metric] += events[e].weight * (double)(end.value - start_reads[i].value) * enabled / running;
+      } else if (enabled > 0.0) {
+        // never scheduled in the interval: the count is unknown
+        sample->values[metric] = NAN;
+      }
+    }
+  }
+}
+
+void perf_counters_close(void) {
+  for (int i = 0; fds != NULL && i < thread_total * event_count; i++) {
+    if (fds[i] >= 0) {
+      close(fds[i]);
+    }
+  }
+  free(fds);
+  free(start_reads);
+  fds = NULL;
+  start_reads = NULL;
+  thread_total = 0;
+  for (int m = 0; m < PERF_METRICS; m++) {
+    metric_available[m] = 0;
+  }
+}
+
+#else
+
+int perf_counters_open(int thread_count) {
+  (void)thread_count;
+  return 0;
+}
+
+void perf_counters_start(void) {}
+
+void perf_counters_stop(PerfSample *sample) {
+  for (int m = 0; m < PERF_METRICS; m++) {
+    sample->values[m] = NAN;
+  }
+}
+
+void perf_counters_close(void) {}
+
+#endif
@@ -0,0 +1,36 @@
+// ABOUTME: Hardware performance counters (perf_event_open) summed over the OpenMP threads
+// ABOUTME: Cycles, instructions, cache/TLB misses and FP operations per measured kernel run
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+typedef enum {
+  PERF_CYCLES,
+  PERF_INSTRUCTIONS,
+  PERF_L1D_MISSES,  // L1 data cache read misses
+  PERF_LLC_MISSES,  // last level cache misses
+  PERF_DTLB_MISSES, // data TLB read misses
+  PERF_FP_OPS,      // double precision operations, an FMA counting 2 (Intel only)
+  PERF_METRICS
+} PerfMetric;
+
+// CSV column names of the metrics, in PerfMetric order
+extern const char *const perf_metric_names[PERF_METRICS];
+
+// counts of one measured interval, summed over all threads and scaled up
+// when the kernel multiplexed the counters; NAN when a metric is unavailable
+typedef struct {
+  double values[PERF_METRICS];
+} PerfSample;
+
+// opens the counters (user space only) on every thread of the process, after
+// growing the OpenMP pool to thread_count threads; threads created later are
+// not counted. Idle pool threads are included, so their spin-waiting shows up
+// in the counts. Returns the number of available metrics, 0 when
+// perf_event_open is not permitted or not supported
+int perf_counters_open(int thread_count);
+void perf_counters_start(void);
+void perf_counters_stop(PerfSample *sample);
+void perf_counters_close(void);
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,139 @@
+#include "mm_recursive.h"
+#include "../main/parameters.h"
+#include <omp.h>
+
+// subproblems with fewer multiply-adds than this are not worth a task
+#define RECURSIVE_TASK_MIN (128.0 * 128.0 * 128.0)
+
+static void base_multiply(size_t m, size_t n, size_t k,
+                          const double *restrict A, size_t lda,
+                          const double *restrict B, size_t ldb,
+                          double *restrict C, size_t ldc) {
+  for (size_t i = 0; i < m; i++) {
+    for (size_t p = 0; p < k; p++) {
+      const double temp = A[i * lda + p];
+      for (size_t j = 0; j < n; j++) {
+        C[i * ldc + j] += temp * B[p * ldb + j];
+      }
+    }
+  }
+}
+
+void recursive_multiply(size_t m, size_t n, size_t k, const double *restrict A,
+                        size_t lda, const double *restrict B, size_t ldb,
+                        double *restrict C, size_t ldc) {
+  if (m <= RECURSIVE_LEAF && n <= RECURSIVE_LEAF && k <= RECURSIVE_LEAF) {
+    base_multiply(m, n, k, A, lda, B, ldb, C, ldc);
+    return;
+  }
+
+  const int spawn = (double)m * (double)n * (double)k >= RECURSIVE_TASK_MIN;
+
+  if (m >= n && m >= k) {
+    const size_t h = m / 2;
+#pragma omp task if (spawn)
+    recursive_multiply(h, n, k, A, lda, B, ldb, C, ldc);
+#pragma omp task if (spawn)
+    recursive_multiply(m - h, n, k, A + h * lda, lda, B, ldb, C + h * ldc, ldc);
+#pragma omp taskwait
+  } else if (n >= k) {
+    const size_t h = n / 2;
+#pragma omp task if (spawn)
+    recursive_multiply(m, h, k, A, lda, B, ldb, C, ldc);
+#pragma omp task if (spawn)
+    recursive_multiply(m, n - h, k, A, lda, B + h, ldb, C + h, ldc);
+#pragma omp taskwait
+  } else {
+    // both halves of k update the same C block
+    const size_t h = k / 2;
+    recursive_multiply(m, n, h, A, lda, B, ldb, C, ldc);
+    recursive_multiply(m, n, k - h, A + h, lda, B + h * ldb, ldb, C, ldc);
+  }
+}
+
+double parallel_multiply_recursive(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                                   int thread_count) {
+  const size_t n = (size_t)a->size;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  matrix_fill_zero(c);
+
+  double start = omp_get_wtime();
+
+#pragma omp parallel num_threads(thread_count), default(none),                 \
+    shared(A, B, C, lda, ldb, ldc, n)
+  {
+#pragma omp single
+    recursive_multiply(n, n, n, A, lda, B, ldb, C, ldc);
+  }
+
+  return omp_get_wtime() - start;
+}
+
+// full tile x tile product on contiguous tiles
+static void tile_multiply(size_t tile, const double *restrict A,
+                          const double *restrict B, double *restrict C) {
+  for (size_t i = 0; i < tile; i++) {
+    for (size_t k = 0; k < tile; k++) {
+      const double temp = A[i * tile + k];
+      for (size_t j = 0; j < tile; j++) {
+        C[i * tile + j] += temp * B[k * tile + j];
+      }
+    }
+  }
+}
+
+// s x s tiles starting at tile (ti, tk) of A, (tk, tj) of B and (ti, tj) of C;
+// each quadrant is the next quarter of the block, and quadrants made only of
+// padding tiles are skipped
+static void recursive_morton(size_t s, size_t ti, size_t tj, size_t tk,
+                             const double *A, const double *B, double *C,
+                             size_t tile, size_t used) {
+  if (ti >= used || tj >= used || tk >= used) {
+    return;
+  }
+  if (s == 1) {
+    tile_multiply(tile, A, B, C);
+    return;
+  }
+
+  const size_t h = s / 2, quadrant = h * h * tile * tile;
+  const double extent = (double)(s * tile);
+  const int spawn = extent * extent * extent >= RECURSIVE_TASK_MIN;
+
+  for (size_t qi = 0; qi < 2; qi++) {
+    for (size_t qj = 0; qj < 2; qj++) {
+      // the four C quadrants are disjoint, their two k halves are not
+#pragma omp task if (spawn)
+      for (size_t qk = 0; qk < 2; qk++) {
+        recursive_morton(h, ti + qi * h, tj + qj * h, tk + qk * h,
+                         A + (2 * qi + qk) * quadrant,
+                         B + (2 * qk + qj) * quadrant,
+                         C + (2 * qi + qj) * quadrant, tile, used);
+      }
+    }
+  }
+#pragma omp taskwait
+}
+
+double parallel_multiply_recursive_morton(const MortonMatrix *restrict a, const MortonMatrix *restrict b,
+                                          MortonMatrix *restrict c, int thread_count) {
+  const size_t tiles = c->tiles, tile = c->tile, used = MORTON_USED_TILES(c);
+  const double *A = a->data;
+  const double *B = b->data;
+  double *C = c->data;
+  morton_fill_zero(c);
+
+  double start = omp_get_wtime();
+
+#pragma omp parallel num_threads(thread_count), default(none),                 \
+    shared(A, B, C, tiles, tile, used)
+  {
+#pragma omp single
+    recursive_morton(tiles, 0, 0, 0, A, B, C, tile, used);
+  }
+
+  return omp_get_wtime() - start;
+}
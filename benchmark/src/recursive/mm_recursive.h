@@ -0,0 +1,28 @@
+// ABOUTME: Cache-oblivious divide-and-conquer matrix multiplication with OpenMP tasks
+// ABOUTME: Halves the largest of m/n/k until a small base case, no block size to tune
+
+#ifndef MM_RECURSIVE_H
+#define MM_RECURSIVE_H
+
+#include "../matrix/matrix.h"
+#include "../matrix/matrix_morton.h"
+
+// largest dimension handled by the i-k-j base case: a 32 x 32 block of each
+// operand is 24 KiB, which fits the L1 of any current core
+#define RECURSIVE_LEAF 32
+
+// C += A * B on an m x k by k x n row-major problem. Splits of m and n write
+// disjoint halves of C and run as tasks, splits of k run one after the other
+void recursive_multiply(size_t m, size_t n, size_t k, const double *restrict A,
+                        size_t lda, const double *restrict B, size_t ldb,
+                        double *restrict C, size_t ldc);
+
+double parallel_multiply_recursive(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                                   int thread_count);
+
+// quadrant recursion on the Z-order layout, where every quadrant is one
+// contiguous chunk; the tile is the base case
+double parallel_multiply_recursive_morton(const MortonMatrix *restrict a, const MortonMatrix *restrict b,
+                                          MortonMatrix *restrict c, int thread_count);
+
+#endif // MM_RECURSIVE_H
@@ -0,0 +1,153 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "roofline.h"
+#include "../gemm/blocking.h"
+#include "../gemm/gemm.h"
+#include "../gemm/microkernel.h"
+#include "../main/parameters.h"
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// the triad arrays are at least this large, and at least ROOFLINE_STREAM_CACHE_MULTIPLE
+// times the last level cache, so that the probe streams from memory
+#define ROOFLINE_STREAM_MIN_BYTES (32u << 20)
+#define ROOFLINE_STREAM_CACHE_MULTIPLE 4
+// flops of each thread in one run of the peak probe
+#define ROOFLINE_PEAK_FLOPS 2e8
+#define ROOFLINE_PROBE_RUNS 5
+
+static Roofline rooflines[ROOFLINE_MAX_THREADS + 1];
+
+static double *roofline_alloc(size_t count) {
+  void *buffer = NULL;
+  if (posix_memalign(&buffer, GEMM_ALIGNMENT, count * sizeof(double)) != 0) {
+    printf("Error: Failed to allocate memory for roofline probe\n");
+    exit(1);
+  }
+  return (double *)buffer;
+}
+
+// best of a few runs of a[i] = b[i] + s * c[i], counting 3 * 8 bytes per
+// element like STREAM (the write-allocate read of a is not counted)
+static double measure_bandwidth(int threads) {
+  size_t bytes = ROOFLINE_STREAM_CACHE_MULTIPLE * host_cache_sizes()->l3;
+  bytes = (bytes < ROOFLINE_STREAM_MIN_BYTES) ? ROOFLINE_STREAM_MIN_BYTES : bytes;
+  const size_t count = bytes / sizeof(double);
+  double *a = roofline_alloc(count);
+  double *b = roofline_alloc(count);
+  double *c = roofline_alloc(count);
+  const double scalar = 3.0;
+
+  // first touch by the same static schedule as the probe
+#pragma omp parallel for num_threads(threads) schedule(static) default(none) shared(a, b, c, count)
+  for (size_t i = 0; i < count; i++) {
+    a[i] = 0.0;
+    b[i] = 1.0;
+    c[i] = 2.0;
+  }
+
+  double best = 0.0;
+  for (int run = 0; run < ROOFLINE_PROBE_RUNS; run++) {
+    double start = omp_get_wtime();
+#pragma omp parallel for num_threads(threads) schedule(static) default(none) shared(a, b, c, count, scalar)
+    for (size_t i = 0; i < count; i++) {
+      a[i] = b[i] + scalar * c[i];
+    }
+    double elapsed = omp_get_wtime() - start;
+    best = (run == 0 || elapsed < best) ? elapsed : best;
+  }
+
+  free(a);
+  free(b);
+  free(c);
+  return 3.0 * (double)bytes / best * 1e-9;
+}
+
+// best of a few runs of every thread calling the micro-kernel on its own
+// packed slivers, sized to half of L1 so that only the FMA units are measured
+static double measure_peak(int threads, const GemmMicroKernel *ukr) {
+  const size_t mr = ukr->mr, nr = ukr->nr;
+  size_t kc = host_cache_sizes()->l1d / 2 / ((mr + nr) * sizeof(double));
+  kc = (kc < 16) ? 16 : kc;
+  const double call_flops = 2.0 * (double)(mr * nr * kc);
+  const long calls = (long)(ROOFLINE_PEAK_FLOPS / call_flops) + 1;
+
+  double best = 0.0;
+  for (int run = 0; run < ROOFLINE_PROBE_RUNS; run++) {
+    double elapsed = 0.0;
+#pragma omp parallel num_threads(threads) default(none) shared(ukr, mr, nr, kc, calls, elapsed)
+    {
+      double *a = roofline_alloc(kc * mr);
+      double *b = roofline_alloc(kc * nr);
+      double c[GEMM_MAX_MR * GEMM_MAX_NR] = {0.0};
+      for (size_t i = 0; i < kc * mr; i++) {
+        a[i] = 1e-3 * (double)(i % 7);
+      }
+      for (size_t i = 0; i < kc * nr; i++) {
+        b[i] = 1e-3 * (double)(i % 5);
+      }
+
+      // the clock starts before any thread is released into the loop
+#pragma omp barrier
+#pragma omp master
+      elapsed = omp_get_wtime();
+#pragma omp barrier
+      for (long call = 0; call < calls; call++) {
+        ukr->kernel(kc, a, b, c, nr);
+      }
+#pragma omp barrier
+#pragma omp master
+      elapsed = omp_get_wtime() - elapsed;
+
+      // keeps the products observable
+      if (c[0] < 0.0) {
+        printf("%f\n", c[0]);
+      }
+      free(a);
+      free(b);
+    }
+    best = (run == 0 || elapsed < best) ? elapsed : best;
+  }
+  return call_flops * (double)calls * threads / best * 1e-9;
+}
+
+const Roofline *roofline_machine(int thread_count) {
+  if (thread_count > ROOFLINE_MAX_THREADS) {
+    thread_count = ROOFLINE_MAX_THREADS;
+  }
+  if (thread_count < 1) {
+    thread_count = 1;
+  }
+
+  Roofline *roofline = &rooflines[thread_count];
+#pragma omp critical(roofline_probe)
+  {
+    if (roofline->thread_count == 0) {
+      const GemmMicroKernel *ukr = gemm_microkernel();
+      roofline->bandwidth_gbs = measure_bandwidth(thread_count);
+      roofline->peak_gflops = measure_peak(thread_count, ukr);
+      roofline->peak_kernel = ukr->name;
+      roofline->thread_count = thread_count;
+#ifdef DEBUG
+      printf("Roofline - %d threads: peak %.2f GFLOP/s (%s), bandwidth %.2f GB/s\n", thread_count,
+             roofline->peak_gflops, roofline->peak_kernel, roofline->bandwidth_gbs);
+#endif
+    }
+  }
+  return roofline;
+}
+
+double roofline_attainable(const Roofline *roofline, double intensity) {
+  const double memory_bound = intensity * roofline->bandwidth_gbs;
+  return (memory_bound < roofline->peak_gflops) ? memory_bound : roofline->peak_gflops;
+}
+
+double gemm_flops(size_t m, size_t n, size_t k) {
+  return 2.0 * (double)m * (double)n * (double)k;
+}
+
+double gemm_intensity(size_t m, size_t n, size_t k) {
+  const double traffic = ((double)m * (double)k + (double)k * (double)n + (double)m * (double)n) * sizeof(double);
+  return gemm_flops(m, n, k) / traffic;
+}
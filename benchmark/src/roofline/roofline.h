@@ -0,0 +1,40 @@
+// ABOUTME: Machine roofline: STREAM triad bandwidth and micro-kernel peak flop rate probes
+// ABOUTME: Bounds the attainable GFLOP/s of a kernel from its arithmetic intensity
+
+#ifndef ROOFLINE_H
+#define ROOFLINE_H
+
+#include <stddef.h>
+
+// team sizes above this are clamped
+#define ROOFLINE_MAX_THREADS 256
+
+// ceilings of one team size
+typedef struct {
+  int thread_count;
+  double peak_gflops;   // gemm micro-kernel on L1-resident slivers
+  double bandwidth_gbs; // STREAM triad on arrays well beyond the last level cache
+  const char *peak_kernel;
+} Roofline;
+
+// the roofline of a team of thread_count threads, probed the first time it is
+// asked for (a fraction of a second) and cached afterwards
+const Roofline *roofline_machine(int thread_count);
+
+// attainable GFLOP/s at the given arithmetic intensity (flop/byte):
+//   min(peak, intensity * bandwidth)
+double roofline_attainable(const Roofline *roofline, double intensity);
+
+// flop count of an (m x k) * (k x n) product, 2 m n k
+double gemm_flops(size_t m, size_t n, size_t k);
+
+// intensity of an (m x k) * (k x n) product against its compulsory traffic,
+// reading A and B and writing C once: 2 m n k / ((m k + k n + m n) * 8 bytes),
+// n / 12 for square matrices. Any kernel moving more data through memory sits
+// left of this point, so it is the optimistic bound
+double gemm_intensity(size_t m, size_t n, size_t k);
+
+// bytes moved from memory per last level cache miss
+#define ROOFLINE_LINE_BYTES 64
+
+#endif // ROOFLINE_H
@@ -0,0 +1,263 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "mm_strassen.h"
+#include "../gemm/gemm.h"
+#include "../main/parameters.h"
+#include <omp.h>
+#include <string.h>
+
+// candidate sizes probed by the cutoff tuning
+#define STRASSEN_TUNE_MIN 128
+#define STRASSEN_TUNE_MAX 1024
+#define STRASSEN_TUNE_RUNS 3
+
+static size_t footprint_current = 0;
+static size_t footprint_peak = 0;
+static int tuned_cutoff = 0;
+
+static double *strassen_alloc(size_t count) {
+  void *buffer = NULL;
+  size_t bytes = count * sizeof(double);
+  if (posix_memalign(&buffer, MATRIX_ALIGNMENT, bytes > 0 ? bytes : 1) != 0) {
+    printf("Error: Failed to allocate memory for Strassen workspace\n");
+    exit(1);
+  }
+#pragma omp critical(strassen_footprint)
+  {
+    footprint_current += bytes;
+    if (footprint_current > footprint_peak) {
+      footprint_peak = footprint_current;
+    }
+  }
+  return (double *)buffer;
+}
+
+static void strassen_free(double *buffer, size_t count) {
+#pragma omp critical(strassen_footprint)
+  footprint_current -= count * sizeof(double);
+  free(buffer);
+}
+
+// Z = X + sign * Y on h x h blocks
+static void block_add(size_t h, const double *restrict X, size_t ldx,
+                      const double *restrict Y, size_t ldy, double sign,
+                      double *restrict Z, size_t ldz) {
+  for (size_t i = 0; i < h; i++) {
+    for (size_t j = 0; j < h; j++) {
+      Z[i * ldz + j] = X[i * ldx + j] + sign * Y[i * ldy + j];
+    }
+  }
+}
+
+// Z += sign * Y on h x h blocks
+static void block_accumulate(size_t h, const double *restrict Y, size_t ldy,
+                             double sign, double *restrict Z, size_t ldz) {
+  for (size_t i = 0; i < h; i++) {
+    for (size_t j = 0; j < h; j++) {
+      Z[i * ldz + j] += sign * Y[i * ldy + j];
+    }
+  }
+}
+
+static void base_multiply(size_t n, const double *restrict A, size_t lda,
+                          const double *restrict B, size_t ldb,
+                          double *restrict C, size_t ldc) {
+  dgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, n, n, n, 1.0, A, lda, B, ldb, 0.0, C, ldc,
+        gemm_host_blocking(), 1);
+}
+
+// Winograd's variant: 7 products and 15 additions per level
+static void strassen_recurse(size_t n, const double *restrict A, size_t lda,
+                             const double *restrict B, size_t ldb,
+                             double *restrict C, size_t ldc, size_t cutoff) {
+  if (n <= cutoff || n % 2 != 0) {
+    base_multiply(n, A, lda, B, ldb, C, ldc);
+    return;
+  }
+
+  const size_t h = n / 2, hh = h * h;
+  const double *A11 = A, *A12 = A + h, *A21 = A + h * lda, *A22 = A21 + h;
+  const double *B11 = B, *B12 = B + h, *B21 = B + h * ldb, *B22 = B21 + h;
+  double *C11 = C, *C12 = C + h, *C21 = C + h * ldc, *C22 = C21 + h;
+
+  double *work = strassen_alloc(15 * hh);
+  double *S1 = work, *S2 = S1 + hh, *S3 = S2 + hh, *S4 = S3 + hh;
+  double *T1 = S4 + hh, *T2 = T1 + hh, *T3 = T2 + hh, *T4 = T3 + hh;
+  double *M1 = T4 + hh, *M2 = M1 + hh, *M3 = M2 + hh, *M4 = M3 + hh;
+  double *M5 = M4 + hh, *M6 = M5 + hh, *M7 = M6 + hh;
+
+#pragma omp task
+  {
+    block_add(h, A21, lda, A22, lda, 1.0, S1, h);
+    block_add(h, S1, h, A11, lda, -1.0, S2, h);
+    block_add(h, A11, lda, A21, lda, -1.0, S3, h);
+    block_add(h, A12, lda, S2, h, -1.0, S4, h);
+  }
+#pragma omp task
+  {
+    block_add(h, B12, ldb, B11, ldb, -1.0, T1, h);
+    block_add(h, B22, ldb, T1, h, -1.0, T2, h);
+    block_add(h, B22, ldb, B12, ldb, -1.0, T3, h);
+    block_add(h, T2, h, B21, ldb, -1.0, T4, h);
+  }
+#pragma omp taskwait
+
+#pragma omp task
+  strassen_recurse(h, A11, lda, B11, ldb, M1, h, cutoff);
+#pragma omp task
+  strassen_recurse(h, A12, lda, B21, ldb, M2, h, cutoff);
+#pragma omp task
+  strassen_recurse(h, S4, h, B22, ldb, M3, h, cutoff);
+#pragma omp task
+  strassen_recurse(h, A22, lda, T4, h, M4, h, cutoff);
+#pragma omp task
+  strassen_recurse(h, S1, h, T1, h, M5, h, cutoff);
+#pragma omp task
+  strassen_recurse(h, S2, h, T2, h, M6, h, cutoff);
+#pragma omp task
+  strassen_recurse(h, S3, h, T3, h, M7, h, cutoff);
+#pragma omp taskwait
+
+  // U2 = M1 + M6, U3 = U2 + M7, U4 = U2 + M5 (built in place in M6 / M7)
+  block_add(h, M1, h, M2, h, 1.0, C11, ldc);
+  block_accumulate(h, M1, h, 1.0, M6, h);
+  block_accumulate(h, M6, h, 1.0, M7, h);
+  block_accumulate(h, M5, h, 1.0, M6, h);
+  block_add(h, M6, h, M3, h, 1.0, C12, ldc);
+  block_add(h, M7, h, M4, h, -1.0, C21, ldc);
+  block_add(h, M7, h, M5, h, 1.0, C22, ldc);
+
+  strassen_free(work, 15 * hh);
+}
+
+// copies the n x n block of src into the top-left of a zeroed padded x padded buffer
+static double *pad_copy(size_t n, size_t padded, const double *restrict src,
+                        size_t ld) {
+  double *dst = strassen_alloc(padded * padded);
+  memset(dst, 0, padded * padded * sizeof(double));
+  for (size_t i = 0; i < n; i++) {
+    memcpy(&dst[i * padded], &src[i * ld], n * sizeof(double));
+  }
+  return dst;
+}
+
+size_t strassen_multiply(size_t n, const double *restrict A, size_t lda,
+                         const double *restrict B, size_t ldb,
+                         double *restrict C, size_t ldc, size_t cutoff,
+                         int thread_count) {
+  footprint_current = footprint_peak = 0;
+  cutoff = (cutoff > 0) ? cutoff : 1;
+
+  // pad so every level halves evenly down to leaves of at most cutoff
+  size_t leaf = n, levels = 0;
+  while (leaf > cutoff) {
+    leaf = (leaf + 1) / 2;
+    levels++;
+  }
+  const size_t padded = leaf << levels;
+
+  const double *A_work = A, *B_work = B;
+  double *C_work = C;
+  size_t lda_work = lda, ldb_work = ldb, ldc_work = ldc;
+  if (padded != n) {
+    A_work = pad_copy(n, padded, A, lda);
+    B_work = pad_copy(n, padded, B, ldb);
+    C_work = strassen_alloc(padded * padded);
+    lda_work = ldb_work = ldc_work = padded;
+  }
+
+#pragma omp parallel num_threads(thread_count), default(none),                 \
+    shared(padded, A_work, lda_work, B_work, ldb_work, C_work, ldc_work, cutoff)
+  {
+#pragma omp single
+    strassen_recurse(padded, A_work, lda_work, B_work, ldb_work, C_work,
+                     ldc_work, cutoff);
+  }
+
+  if (padded != n) {
+    for (size_t i = 0; i < n; i++) {
+      memcpy(&C[i * ldc], &C_work[i * padded], n * sizeof(double));
+    }
+    strassen_free((double *)A_work, padded * padded);
+    strassen_free((double *)B_work, padded * padded);
+    strassen_free(C_work, padded * padded);
+  }
+
+  return footprint_peak;
+}
+
+// One level of recursion pays off from the first probed size where it beats
+// the direct kernel; the cutoff is put between that size and the one before.
+static int tune_cutoff(void) {
+  int cutoff = STRASSEN_TUNE_MAX;
+  Matrix a, b, c;
+  matrix_create(&a, STRASSEN_TUNE_MAX);
+  matrix_create(&b, STRASSEN_TUNE_MAX);
+  matrix_create(&c, STRASSEN_TUNE_MAX);
+  matrix_fill_random(&a);
+  matrix_fill_random(&b);
+
+  for (size_t n = STRASSEN_TUNE_MIN; n <= STRASSEN_TUNE_MAX; n *= 2) {
+    // best of a few runs, the first one also warms up caches and buffers
+    double direct = 0.0, one_level = 0.0;
+    for (int run = 0; run < STRASSEN_TUNE_RUNS; run++) {
+      double start = omp_get_wtime();
+      base_multiply(n, a.data, a.ld, b.data, b.ld, c.data, c.ld);
+      double elapsed = omp_get_wtime() - start;
+      direct = (run == 0 || elapsed < direct) ? elapsed : direct;
+
+      start = omp_get_wtime();
+      strassen_multiply(n, a.data, a.ld, b.data, b.ld, c.data, c.ld, n / 2, 1);
+      elapsed = omp_get_wtime() - start;
+      one_level = (run == 0 || elapsed < one_level) ? elapsed : one_level;
+    }
+
+    if (one_level < direct) {
+      cutoff = (int)(n * 3 / 4);
+      break;
+    }
+  }
+
+  matrix_destroy(&a);
+  matrix_destroy(&b);
+  matrix_destroy(&c);
+  return cutoff;
+}
+
+int strassen_tuned_cutoff(void) {
+#pragma omp critical(strassen_tuning)
+  {
+    if (tuned_cutoff == 0) {
+      tuned_cutoff = tune_cutoff();
+    }
+  }
+  return tuned_cutoff;
+}
+
+double parallel_multiply_strassen(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                                  int thread_count, int cutoff, size_t *peak_bytes) {
+  const size_t n = (size_t)a->size;
+  if (cutoff == STRASSEN_CUTOFF_AUTO) {
+    cutoff = strassen_tuned_cutoff();
+  }
+
+  double start = omp_get_wtime();
+
+  size_t peak = strassen_multiply(n, a->data, a->ld, b->data, b->ld, c->data,
+                                  c->ld, (size_t)cutoff, thread_count);
+
+  double result = omp_get_wtime() - start;
+
+  if (peak_bytes != NULL) {
+    *peak_bytes = peak;
+  }
+
+#ifdef DEBUG
+  printf("Parallel - Strassen-Winograd - matrix size: %d, threads: %d, cutoff: "
+         "%d - extra memory: %.2f MiB - time: %f\n",
+         a->size, thread_count, cutoff, (double)peak / (1024.0 * 1024.0),
+         result);
+#endif
+
+  return result;
+}
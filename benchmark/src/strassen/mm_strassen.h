@@ -0,0 +1,26 @@
+// ABOUTME: Strassen-Winograd recursive matrix multiplication parallelized with OpenMP tasks
+// ABOUTME: Recursion stops at a tuned cutoff and falls back to the packed GEMM engine
+
+#ifndef MM_STRASSEN_H
+#define MM_STRASSEN_H
+
+#include "../matrix/matrix.h"
+
+// cutoff value that selects the tuned cutoff
+#define STRASSEN_CUTOFF_AUTO 0
+
+// smallest subproblem size handed to the base kernel, measured once per host
+int strassen_tuned_cutoff(void);
+
+// C = A * B on n x n row-major buffers; odd sizes are zero-padded to
+// cutoff-sized leaves. Returns the peak extra memory (workspace and padding)
+// in bytes
+size_t strassen_multiply(size_t n, const double *restrict A, size_t lda,
+                         const double *restrict B, size_t ldb,
+                         double *restrict C, size_t ldc, size_t cutoff,
+                         int thread_count);
+
+double parallel_multiply_strassen(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                                  int thread_count, int cutoff, size_t *peak_bytes);
+
+#endif // MM_STRASSEN_H
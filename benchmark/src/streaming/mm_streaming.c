@@ -0,0 +1,233 @@
+#define _DEFAULT_SOURCE
+#define _FILE_OFFSET_BITS 64
+
+#include "mm_streaming.h"
+#include "../gemm/gemm.h"
+#include "../matrix/matrix.h"
+#include "../main/parameters.h"
+#include <fcntl.h>
+#include <math.h>
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// a matrix file mapped whole: the header at base, row i of the payload at
+// data + i * ld
+typedef struct {
+  char *base;
+  double *data;
+  size_t bytes;
+  size_t ld;
+  int fd;
+} MappedFile;
+
+// maps the matrix file at path, which must hold an n x n matrix; create
+// replaces it by a zero n x n matrix with rows padded like matrix_create
+static void map_file(MappedFile *file, const char *path, size_t n, int writable, int create) {
+  int flags = writable ? O_RDWR : O_RDONLY;
+  if (create) {
+    flags |= O_CREAT | O_TRUNC;
+  }
+
+  file->fd = open(path, flags, 0644);
+  if (file->fd < 0) {
+    printf("Error: Failed to open %s\n", path);
+    exit(1);
+  }
+
+  MatrixFileHeader header;
+  if (create) {
+    matrix_file_header(&header, n, matrix_padded_ld(n));
+    file->bytes = header.header_bytes + header.ld * n * sizeof(double);
+    if (ftruncate(file->fd, (off_t)file->bytes) != 0 ||
+        pwrite(file->fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+      printf("Error: Failed to resize %s to %zu bytes\n", path, file->bytes);
+      exit(1);
+    }
+  } else {
+    file->bytes = matrix_file_read_header(file->fd, path, &header);
+    if (header.rows != n) {
+      printf("Error: %s holds a %llu x %llu matrix, expected %zu x %zu\n", path, (unsigned long long)header.rows,
+             (unsigned long long)header.cols, n, n);
+      exit(1);
+    }
+  }
+
+  void *base = mmap(NULL, file->bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file->fd, 0);
+  if (base == MAP_FAILED) {
+    printf("Error: Failed to map %s\n", path);
+    exit(1);
+  }
+  file->base = (char *)base;
+  file->data = (double *)(file->base + header.header_bytes);
+  file->ld = (size_t)header.ld;
+}
+
+size_t streaming_matrix_size(const char *path) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    printf("Error: Failed to open %s\n", path);
+    exit(1);
+  }
+  MatrixFileHeader header;
+  matrix_file_read_header(fd, path, &header);
+  close(fd);
+  return (size_t)header.rows;
+}
+
+static void unmap_file(MappedFile *file) {
+  munmap(file->base, file->bytes);
+  close(file->fd);
+  file->base = NULL;
+  file->data = NULL;
+}
+
+// madvise on the pages covering count rows starting at row first
+static void advise(const MappedFile *file, size_t first, size_t count, int advice) {
+  const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  const size_t offset = (size_t)((char *)file->data - file->base);
+  size_t begin = (offset + first * file->ld * sizeof(double)) / page * page;
+  size_t end = offset + (first + count) * file->ld * sizeof(double);
+  end = (end + page - 1) / page * page;
+  end = (end > file->bytes) ? file->bytes : end;
+  if (end > begin) {
+    madvise(file->base + begin, end - begin, advice);
+  }
+}
+
+// writes dirty rows back asynchronously and drops them from the mapping
+static void release(const MappedFile *file, size_t first, size_t count) {
+  const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  const size_t offset = (size_t)((char *)file->data - file->base);
+  size_t begin = (offset + first * file->ld * sizeof(double)) / page * page;
+  size_t end = offset + (first + count) * file->ld * sizeof(double);
+  end = (end > file->bytes) ? file->bytes : end;
+  msync(file->base + begin, end - begin, MS_ASYNC);
+  advise(file, first, count, MADV_DONTNEED);
+}
+
+// rows per panel such that the A and C panels and two B chunks of the same
+// height, 4 * rows * n doubles, fit the budget
+static size_t budget_rows(size_t n, size_t memory_budget) {
+  size_t rows = memory_budget / (4 * n * sizeof(double));
+  if (rows < 1) {
+    rows = 1;
+  }
+  return (rows > n) ? n : rows;
+}
+
+void streaming_create_random(const char *path, size_t n, size_t memory_budget) {
+  if (n == 0) {
+    return;
+  }
+  MappedFile file;
+  map_file(&file, path, n, 1, 1);
+  const size_t rows = budget_rows(n, memory_budget);
+  double *data = file.data;
+  const size_t ld = file.ld;
+  const uint64_t key = matrix_random_stream();
+
+  for (size_t first = 0; first < n; first += rows) {
+    size_t last = (first + rows > n) ? n : first + rows;
+#pragma omp parallel for default(none), shared(data, n, ld, first, last, key)
+    for (size_t i = first; i < last; i++) {
+#pragma omp simd
+      for (size_t j = 0; j < n; j++) {
+        data[i * ld + j] = UNIFORM_MIN + (UNIFORM_MAX - UNIFORM_MIN) * matrix_random_unit(key, (uint64_t)(i * n + j));
+      }
+    }
+    release(&file, first, last - first);
+  }
+
+  unmap_file(&file);
+}
+
+double streaming_multiply(const char *path_a, const char *path_b, const char *path_c, size_t n,
+                          size_t memory_budget, int thread_count, size_t *panel_rows) {
+  const size_t rows = budget_rows(n, memory_budget);
+  *panel_rows = rows;
+  if (n == 0) {
+    return 0.0;
+  }
+
+  double start = omp_get_wtime();
+
+  MappedFile a, b, c;
+  map_file(&a, path_a, n, 0, 0);
+  map_file(&b, path_b, n, 0, 0);
+  map_file(&c, path_c, n, 1, 1);
+  advise(&a, 0, n, MADV_SEQUENTIAL);
+  advise(&b, 0, n, MADV_SEQUENTIAL);
+  advise(&a, 0, rows, MADV_WILLNEED);
+  advise(&b, 0, rows, MADV_WILLNEED);
+
+  for (size_t i0 = 0; i0 < n; i0 += rows) {
+    const size_t h = (i0 + rows > n) ? n - i0 : rows;
+
+    for (size_t k0 = 0; k0 < n; k0 += rows) {
+      const size_t kb = (k0 + rows > n) ? n - k0 : rows;
+
+      // prefetch the next B chunk, or the first one and the next A panel
+      if (k0 + rows < n) {
+        advise(&b, k0 + rows, rows, MADV_WILLNEED);
+      } else if (i0 + rows < n) {
+        advise(&b, 0, rows, MADV_WILLNEED);
+        advise(&a, i0 + rows, rows, MADV_WILLNEED);
+      }
+
+      // beta = 0 on the first chunk: C is never read back from disk
+      dgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, h, n, kb, 1.0, &a.data[i0 * a.ld + k0], a.ld, &b.data[k0 * b.ld], b.ld,
+            (k0 == 0) ? 0.0 : 1.0, &c.data[i0 * c.ld], c.ld, NULL, thread_count);
+
+      // B is streamed again for the next panel unless it fits in one chunk
+      if (rows < n) {
+        advise(&b, k0, kb, MADV_DONTNEED);
+      }
+    }
+
+    advise(&a, i0, h, MADV_DONTNEED);
+    release(&c, i0, h);
+  }
+
+  if (msync(c.base, c.bytes, MS_SYNC) != 0) {
+    printf("Error: Failed to write back %s\n", path_c);
+    exit(1);
+  }
+  unmap_file(&a);
+  unmap_file(&b);
+  unmap_file(&c);
+
+  return omp_get_wtime() - start;
+}
+
+double streaming_sample_error(const char *path_a, const char *path_b, const char *path_c, size_t n, int samples) {
+  if (n == 0) {
+    return 0.0;
+  }
+  MappedFile a, b, c;
+  map_file(&a, path_a, n, 0, 0);
+  map_file(&b, path_b, n, 0, 0);
+  map_file(&c, path_c, n, 0, 0);
+
+  double max_error = 0.0;
+  // the entries come from a stream of the run seed like every input
+  const uint64_t key = matrix_random_stream();
+  for (int s = 0; s < samples; s++) {
+    size_t i = (size_t)(matrix_random_bits(key, 2 * (uint64_t)s) % n);
+    size_t j = (size_t)(matrix_random_bits(key, 2 * (uint64_t)s + 1) % n);
+    double expected = 0.0;
+#pragma omp parallel for reduction(+ : expected), default(none), shared(a, b, n, i, j)
+    for (size_t k = 0; k < n; k++) {
+      expected += a.data[i * a.ld + k] * b.data[k * b.ld + j];
+    }
+    double error = fabs(expected - c.data[i * c.ld + j]);
+    max_error = (error > max_error) ? error : max_error;
+  }
+
+  unmap_file(&a);
+  unmap_file(&b);
+  unmap_file(&c);
+  return max_error;
+}
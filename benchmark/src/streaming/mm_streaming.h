@@ -0,0 +1,36 @@
+// ABOUTME: Out-of-core matrix multiplication on memory-mapped files larger than RAM
+// ABOUTME: Streams row panels of A and C and row chunks of B within a memory budget
+
+#ifndef MM_STREAMING_H
+#define MM_STREAMING_H
+
+#include <stddef.h>
+
+// Matrices are binary matrix files (MatrixFileHeader in matrix.h), the format
+// matrix_load and matrix_store use, so the same files feed --a/--b of the
+// other benchmarks. Inputs may have any ld; C is written with padded rows. All
+// indexing and offsets are 64-bit, so n is only limited by the disk.
+
+// size n of the n x n matrix in a binary matrix file; exits on a bad header
+size_t streaming_matrix_size(const char *path);
+
+// creates (or truncates) path and fills it with uniform random values from a
+// fresh matrix_random_stream, one budget-sized panel at a time
+void streaming_create_random(const char *path, size_t n, size_t memory_budget);
+
+// C = A * B from/to the files. C is computed in row panels of panel_rows rows:
+// the A and C panels stay mapped while B is streamed in chunks of panel_rows
+// rows, and the next chunk (or the next A panel) is prefetched with
+// madvise(MADV_WILLNEED) while the current one is multiplied. The two panels
+// plus two B chunks fit in memory_budget bytes. Each chunk product runs on the
+// packed GEMM engine with thread_count threads. Returns the elapsed time,
+// I/O included; *panel_rows receives the chosen panel height
+double streaming_multiply(const char *path_a, const char *path_b, const char *path_c, size_t n,
+                          size_t memory_budget, int thread_count, size_t *panel_rows);
+
+// max abs difference between samples entries of C, picked on a fresh
+// matrix_random_stream so a run is reproduced by its seed, and the same
+// entries recomputed directly from A and B
+double streaming_sample_error(const char *path_a, const char *path_b, const char *path_c, size_t n, int samples);
+
+#endif // MM_STREAMING_H
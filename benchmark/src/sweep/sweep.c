@@ -0,0 +1,761 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "sweep.h"
+#include "../adaptive/mm_adaptive.h"
+#include "../gemm/gemm.h"
+#include "../loop_permutations/parallel/mm_parallel.h"
+#include "../loop_permutations/serial/mm_serial.h"
+#include "../main/parameters.h"
+#include "../matrix/matrix.h"
+#include "../recursive/mm_recursive.h"
+#include "../roofline/roofline.h"
+#include "../strassen/mm_strassen.h"
+#include "../tiled/parallel/mm_tiled_parallel.h"
+#include "../tiled/serial/mm_tiled_serial.h"
+#include "../topology/topology.h"
+#include "../utils/utils.h"
+#include <ctype.h>
+#include <math.h>
+#include <omp.h>
+#include <string.h>
+
+// operands of one sweep point as raw row-major buffers; for square shapes
+// a, b and c view the same buffers as matrices
+typedef struct {
+  SweepShape shape;
+  double *A;
+  double *B;
+  double *C;
+  size_t lda;
+  size_t ldb;
+  size_t ldc;
+  Matrix a;
+  Matrix b;
+  Matrix c;
+} SweepProblem;
+
+typedef enum { SWEEP_NO_PARAMETER, SWEEP_CHUNK, SWEEP_BLOCK } SweepParameter;
+
+typedef double (*sweep_kernel_fn)(SweepProblem *problem, int variant, int thread_count, int parameter);
+
+typedef struct {
+  const char *name;
+  SweepParameter parameter;
+  int parallel;    // runs every thread count, otherwise a single thread
+  int rectangular; // also runs non-square shapes
+  int variant;     // loop order of the permutation kernels
+  sweep_kernel_fn run;
+} SweepKernel;
+
+static double run_serial_loop(SweepProblem *p, int variant, int thread_count, int parameter) {
+  (void)thread_count;
+  (void)parameter;
+  return serial_loop_benchmark_functions[variant](&p->a, &p->b, &p->c);
+}
+
+static double run_parallel_loop(SweepProblem *p, int variant, int thread_count, int chunk) {
+  return parallel_loop_benchmark_functions[variant](&p->a, &p->b, &p->c, thread_count, chunk);
+}
+
+static double run_adaptive_ikj(SweepProblem *p, int variant, int thread_count, int chunk) {
+  (void)variant;
+  return adaptive_multiply_ikj(&p->a, &p->b, &p->c, thread_count, chunk);
+}
+
+static double run_serial_tiled(SweepProblem *p, int variant, int thread_count, int block_size) {
+  (void)variant;
+  (void)thread_count;
+  return serial_multiply_tiled(&p->a, &p->b, &p->c, block_size);
+}
+
+static double run_parallel_tiled(SweepProblem *p, int variant, int thread_count, int block_size) {
+  (void)variant;
+  return parallel_multiply_tiled(&p->a, &p->b, &p->c, thread_count, block_size);
+}
+
+static double run_parallel_tiled_tasks(SweepProblem *p, int variant, int thread_count, int block_size) {
+  (void)variant;
+  return parallel_multiply_tiled_tasks(&p->a, &p->b, &p->c, thread_count, block_size);
+}
+
+static double run_serial_tiled_packed(SweepProblem *p, int variant, int thread_count, int block_size) {
+  (void)variant;
+  (void)thread_count;
+  return serial_multiply_tiled_packed(&p->a, &p->b, &p->c, block_size);
+}
+
+static double run_parallel_tiled_packed(SweepProblem *p, int variant, int thread_count, int block_size) {
+  (void)variant;
+  return parallel_multiply_tiled_packed(&p->a, &p->b, &p->c, thread_count, block_size);
+}
+
+static double run_parallel_tiled_ksplit(SweepProblem *p, int variant, int thread_count, int block_size) {
+  (void)variant;
+  return parallel_multiply_tiled_ksplit(&p->a, &p->b, &p->c, thread_count, block_size);
+}
+
+static double run_adaptive_tiled(SweepProblem *p, int variant, int thread_count, int block_size) {
+  (void)variant;
+  return adaptive_multiply_tiled(&p->a, &p->b, &p->c, thread_count, block_size);
+}
+
+static double run_strassen(SweepProblem *p, int variant, int thread_count, int parameter) {
+  (void)variant;
+  (void)parameter;
+  size_t bytes = 0;
+  return parallel_multiply_strassen(&p->a, &p->b, &p->c, thread_count, STRASSEN_CUTOFF_AUTO, &bytes);
+}
+
+static double run_parallel_recursive(SweepProblem *p, int variant, int thread_count, int parameter) {
+  (void)variant;
+  (void)parameter;
+  return parallel_multiply_recursive(&p->a, &p->b, &p->c, thread_count);
+}
+
+// the packed engine on the raw buffers, the only kernel taking m x k and k x n
+static double run_gemm(SweepProblem *p, int variant, int thread_count, int block_size) {
+  (void)variant;
+  GemmBlocking blocking;
+  gemm_blocking_select(block_size, &blocking);
+  double start = omp_get_wtime();
+  dgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, p->shape.m, p->shape.n, p->shape.k, 1.0, p->A, p->lda, p->B, p->ldb, 0.0,
+        p->C, p->ldc, &blocking, thread_count);
+  return omp_get_wtime() - start;
+}
+
+static const SweepKernel sweep_kernels[] = {
+    {"SERIAL_IJK", SWEEP_NO_PARAMETER, 0, 0, 0, run_serial_loop},
+    {"SERIAL_IKJ", SWEEP_NO_PARAMETER, 0, 0, 1, run_serial_loop},
+    {"SERIAL_JIK", SWEEP_NO_PARAMETER, 0, 0, 2, run_serial_loop},
+    {"SERIAL_JKI", SWEEP_NO_PARAMETER, 0, 0, 3, run_serial_loop},
+    {"SERIAL_KIJ", SWEEP_NO_PARAMETER, 0, 0, 4, run_serial_loop},
+    {"SERIAL_KJI", SWEEP_NO_PARAMETER, 0, 0, 5, run_serial_loop},
+    {"PARALLEL_IJK", SWEEP_CHUNK, 1, 0, 0, run_parallel_loop},
+    {"PARALLEL_IKJ", SWEEP_CHUNK, 1, 0, 1, run_parallel_loop},
+    {"PARALLEL_JIK", SWEEP_CHUNK, 1, 0, 2, run_parallel_loop},
+    {"PARALLEL_JKI", SWEEP_CHUNK, 1, 0, 3, run_parallel_loop},
+    {"PARALLEL_KIJ", SWEEP_CHUNK, 1, 0, 4, run_parallel_loop},
+    {"PARALLEL_KJI", SWEEP_CHUNK, 1, 0, 5, run_parallel_loop},
+    {"ADAPTIVE_IKJ", SWEEP_CHUNK, 1, 0, 0, run_adaptive_ikj},
+    {"SERIAL_TILED", SWEEP_BLOCK, 0, 0, 0, run_serial_tiled},
+    {"PARALLEL_TILED", SWEEP_BLOCK, 1, 0, 0, run_parallel_tiled},
+    {"PARALLEL_TILED_TASKS", SWEEP_BLOCK, 1, 0, 0, run_parallel_tiled_tasks},
+    {"SERIAL_TILED_PACKED", SWEEP_BLOCK, 0, 0, 0, run_serial_tiled_packed},
+    {"PARALLEL_TILED_PACKED", SWEEP_BLOCK, 1, 0, 0, run_parallel_tiled_packed},
+    {"PARALLEL_TILED_KSPLIT", SWEEP_BLOCK, 1, 0, 0, run_parallel_tiled_ksplit},
+    {"ADAPTIVE_TILED", SWEEP_BLOCK, 1, 0, 0, run_adaptive_tiled},
+    {"STRASSEN", SWEEP_NO_PARAMETER, 1, 0, 0, run_strassen},
+    {"PARALLEL_RECURSIVE", SWEEP_NO_PARAMETER, 1, 0, 0, run_parallel_recursive},
+    {"GEMM", SWEEP_BLOCK, 1, 1, 0, run_gemm},
+};
+
+#define SWEEP_KERNELS ((int)(sizeof(sweep_kernels) / sizeof(sweep_kernels[0])))
+
+static const char *const parameter_names[] = {"-", "chunk size", "block size"};
+
+static void sweep_list_kernels(void) {
+  for (int i = 0; i < SWEEP_KERNELS; i++) {
+    printf("  %-22s %-8s %s%s\n", sweep_kernels[i].name, sweep_kernels[i].parallel ? "parallel" : "serial",
+           parameter_names[sweep_kernels[i].parameter], sweep_kernels[i].rectangular ? ", rectangular" : "");
+  }
+}
+
+static void sweep_usage(const char *program_name) {
+  printf("Usage: %s [--config FILE] [--kernels LIST] [--sizes LIST] [--shapes LIST] [--threads LIST] "
+         "[--chunks LIST] [--blocks LIST] [--warmup N] [--repetitions N] [--max-repetitions N] "
+         "[--target-ci X] [--trials N] [--scaling strong|weak|both] [--list-kernels] [output_folder]\n",
+         program_name);
+  printf("--config: read options from a file of 'name = value' lines (name without the dashes, 'output' "
+         "for the output folder); later options override it\n");
+  printf("LIST: comma separated values and ranges, a:b:s steps by s, a:b:*f multiplies by f, 'max' is the "
+         "number of processors\n");
+  printf("--kernels: kernel names (see --list-kernels) or 'all'\n");
+  printf("--sizes: square matrix sizes; --shapes: MxNxK products (C is M x N, the inner dimension K)\n");
+  printf("--trials: Freivalds trials per product (default %d, 0 skips the check)\n", FREIVALDS_TRIALS);
+  printf("--scaling: scaling suite of the parallel kernels over --threads (1 added), strong at the --sizes, weak "
+         "from them at n^3 / threads constant\n");
+  exit(1);
+}
+
+// one value of an integer list: a number or "max"
+static int parse_value(const char *text, char **end) {
+  if (strncmp(text, "max", 3) == 0) {
+    *end = (char *)text + 3;
+    return omp_get_num_procs();
+  }
+  long value = strtol(text, end, 10);
+  if (*end == text || value < 0 || value > 1L << 30) {
+    *end = (char *)text;
+    return -1;
+  }
+  return (int)value;
+}
+
+// comma separated values and a:b:s / a:b:*f ranges, without repeats (such as
+// "1,max" on one processor); returns the count, or -1 on a malformed list
+static int parse_int_list(const char *text, int *values) {
+  int count = 0;
+  const char *token = text;
+  while (*token != '\0') {
+    char *end;
+    int first = parse_value(token, &end);
+    int last = first, step = 1, factor = 1;
+    if (first < 0) {
+      return -1;
+    }
+    if (*end == ':') {
+      last = parse_value(end + 1, &end);
+      if (last < first || *end != ':') {
+        return -1;
+      }
+      if (end[1] == '*') {
+        factor = parse_value(end + 2, &end);
+        step = 0;
+        if (factor < 2 || first == 0) {
+          return -1;
+        }
+      } else {
+        step = parse_value(end + 1, &end);
+        if (step < 1) {
+          return -1;
+        }
+      }
+    }
+    for (long value = first; value <= last; value = (step > 0) ? value + step : value * factor) {
+      int repeated = 0;
+      for (int i = 0; i < count; i++) {
+        repeated = repeated || values[i] == value;
+      }
+      if (repeated) {
+        continue;
+      }
+      if (count == SWEEP_MAX_VALUES) {
+        return -1;
+      }
+      values[count++] = (int)value;
+    }
+    if (*end == ',') {
+      end++;
+    } else if (*end != '\0') {
+      return -1;
+    }
+    token = end;
+  }
+  return count;
+}
+
+static int parse_shape_list(const char *text, SweepShape *shapes) {
+  int count = 0;
+  const char *token = text;
+  while (*token != '\0') {
+    char *end;
+    long dims[3];
+    for (int d = 0; d < 3; d++) {
+      dims[d] = strtol(token, &end, 10);
+      if (end == token || dims[d] < 1 || (d < 2 && *end != 'x')) {
+        return -1;
+      }
+      token = (d < 2) ? end + 1 : end;
+    }
+    if (count == SWEEP_MAX_VALUES) {
+      return -1;
+    }
+    shapes[count].m = (size_t)dims[0];
+    shapes[count].n = (size_t)dims[1];
+    shapes[count].k = (size_t)dims[2];
+    count++;
+    if (*end == ',') {
+      end++;
+    } else if (*end != '\0') {
+      return -1;
+    }
+    token = end;
+  }
+  return count;
+}
+
+static int parse_kernel_list(const char *text, int *kernels) {
+  if (strcmp(text, "all") == 0) {
+    for (int i = 0; i < SWEEP_KERNELS; i++) {
+      kernels[i] = i;
+    }
+    return SWEEP_KERNELS;
+  }
+  int count = 0;
+  const char *token = text;
+  while (*token != '\0') {
+    size_t length = strcspn(token, ",");
+    int found = -1;
+    for (int i = 0; i < SWEEP_KERNELS; i++) {
+      if (strlen(sweep_kernels[i].name) == length && strncmp(sweep_kernels[i].name, token, length) == 0) {
+        found = i;
+      }
+    }
+    if (found < 0) {
+      printf("Error: unknown kernel %.*s\n", (int)length, token);
+      return -1;
+    }
+    if (count == SWEEP_MAX_VALUES) {
+      return -1;
+    }
+    kernels[count++] = found;
+    token += length + (token[length] == ',');
+  }
+  return count;
+}
+
+// lists of sizes and thread counts must not hold 0, chunk/block lists may
+// (0 is the host-derived block size)
+static void parse_positive_list(const char *text, int *values, int *count, int allow_zero, const char *program) {
+  int parsed = parse_int_list(text, values);
+  if (parsed < 1) {
+    sweep_usage(program);
+  }
+  for (int i = 0; i < parsed; i++) {
+    if (values[i] == 0 && !allow_zero) {
+      sweep_usage(program);
+    }
+  }
+  *count = parsed;
+}
+
+static void parse_config_file(SweepConfig *config, const char *path, const char *program);
+
+// applies one option, name without the leading dashes; blanks inside the
+// value are ignored, so lists may be written "1, 2, 4"
+static void apply_option(SweepConfig *config, const char *name, const char *text, const char *program) {
+  char value[4096];
+  size_t length = 0;
+  for (const char *c = text; *c != '\0' && length + 1 < sizeof(value); c++) {
+    if (!isspace((unsigned char)*c)) {
+      value[length++] = *c;
+    }
+  }
+  value[length] = '\0';
+
+  if (strcmp(name, "config") == 0) {
+    parse_config_file(config, value, program);
+  } else if (strcmp(name, "output") == 0) {
+    config->output_folder = strdup(value);
+  } else if (strcmp(name, "kernels") == 0) {
+    config->kernel_count = parse_kernel_list(value, config->kernels);
+    if (config->kernel_count < 1) {
+      sweep_usage(program);
+    }
+  } else if (strcmp(name, "sizes") == 0) {
+    parse_positive_list(value, config->sizes, &config->size_count, 0, program);
+  } else if (strcmp(name, "shapes") == 0) {
+    config->shape_count = parse_shape_list(value, config->shapes);
+    if (config->shape_count < 1) {
+      sweep_usage(program);
+    }
+  } else if (strcmp(name, "threads") == 0) {
+    parse_positive_list(value, config->threads, &config->thread_count, 0, program);
+  } else if (strcmp(name, "chunks") == 0) {
+    parse_positive_list(value, config->chunks, &config->chunk_count, 0, program);
+  } else if (strcmp(name, "blocks") == 0) {
+    parse_positive_list(value, config->blocks, &config->block_count, 1, program);
+  } else if (strcmp(name, "warmup") == 0) {
+    config->timing.warmup_runs = atoi(value);
+  } else if (strcmp(name, "repetitions") == 0) {
+    config->timing.min_repetitions = atoi(value);
+  } else if (strcmp(name, "max-repetitions") == 0) {
+    config->timing.max_repetitions = atoi(value);
+  } else if (strcmp(name, "target-ci") == 0) {
+    config->timing.target_ci = atof(value);
+  } else if (strcmp(name, "trials") == 0) {
+    config->freivalds_trials = atoi(value);
+  } else if (strcmp(name, "scaling") == 0) {
+    if (strcmp(value, "strong") == 0) {
+      config->scaling = SWEEP_SCALING_STRONG;
+    } else if (strcmp(value, "weak") == 0) {
+      config->scaling = SWEEP_SCALING_WEAK;
+    } else if (strcmp(value, "both") == 0) {
+      config->scaling = SWEEP_SCALING_BOTH;
+    } else {
+      sweep_usage(program);
+    }
+  } else {
+    printf("Error: unknown option %s\n", name);
+    sweep_usage(program);
+  }
+}
+
+static char *trim(char *text) {
+  while (isspace((unsigned char)*text)) {
+    text++;
+  }
+  char *end = text + strlen(text);
+  while (end > text && isspace((unsigned char)end[-1])) {
+    *--end = '\0';
+  }
+  return text;
+}
+
+static void parse_config_file(SweepConfig *config, const char *path, const char *program) {
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    printf("Error opening file %s\n", path);
+    exit(1);
+  }
+  char line[4096];
+  int number = 0;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    number++;
+    line[strcspn(line, "#\n")] = '\0';
+    char *name = trim(line);
+    if (*name == '\0') {
+      continue;
+    }
+    char *equals = strchr(name, '=');
+    if (equals == NULL) {
+      printf("Error: %s:%d: expected name = value\n", path, number);
+      exit(1);
+    }
+    *equals = '\0';
+    apply_option(config, trim(name), trim(equals + 1), program);
+  }
+  fclose(file);
+}
+
+static void copy_list(const int *source, int count, int *values, int *value_count) {
+  memcpy(values, source, (size_t)count * sizeof(int));
+  *value_count = count;
+}
+
+// powers of two up to the physical cores, the core count itself, then
+// doubling through the SMT siblings up to every logical CPU
+static int scaling_thread_list(int *values) {
+  const Topology *topology = host_topology();
+  int count = 0;
+  for (int threads = 1; threads < topology->physical_cores; threads *= 2) {
+    values[count++] = threads;
+  }
+  for (int threads = topology->physical_cores; threads < topology->logical_cpus; threads *= 2) {
+    values[count++] = threads;
+  }
+  values[count++] = topology->logical_cpus;
+  return count;
+}
+
+// ascending thread counts starting at the one-thread baseline
+static void scaling_thread_order(int *values, int *count) {
+  int has_one = 0;
+  for (int i = 0; i < *count; i++) {
+    has_one = has_one || values[i] == 1;
+  }
+  if (!has_one) {
+    values[(*count < SWEEP_MAX_VALUES) ? (*count)++ : *count - 1] = 1;
+  }
+  for (int i = 1; i < *count; i++) {
+    for (int j = i; j > 0 && values[j - 1] > values[j]; j--) {
+      const int swap = values[j];
+      values[j] = values[j - 1];
+      values[j - 1] = swap;
+    }
+  }
+}
+
+void sweep_parse_args(int argc, char *argv[], SweepConfig *config) {
+  const int sizes[] = MATRIX_SIZES, chunks[] = CHUNK_SIZES, blocks[] = BLOCK_SIZES, threads[] = {THREAD_COUNT};
+
+  config->output_folder = NULL;
+  parse_kernel_list("all", config->kernels);
+  config->kernel_count = SWEEP_KERNELS;
+  copy_list(sizes, (int)(sizeof(sizes) / sizeof(sizes[0])), config->sizes, &config->size_count);
+  config->shape_count = 0;
+  config->thread_count = 0; // THREAD_COUNT, or the topology list under --scaling
+  copy_list(chunks, (int)(sizeof(chunks) / sizeof(chunks[0])), config->chunks, &config->chunk_count);
+  copy_list(blocks, (int)(sizeof(blocks) / sizeof(blocks[0])), config->blocks, &config->block_count);
+  config->timing.warmup_runs = WARMUP_RUNS;
+  config->timing.min_repetitions = REPETITIONS;
+  config->timing.max_repetitions = MAX_REPETITIONS;
+  config->timing.target_ci = TARGET_CI;
+  config->freivalds_trials = FREIVALDS_TRIALS;
+  config->scaling = SWEEP_SCALING_NONE;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--list-kernels") == 0) {
+      sweep_list_kernels();
+      exit(0);
+    } else if (strncmp(argv[i], "--", 2) == 0 && i + 1 < argc) {
+      apply_option(config, argv[i] + 2, argv[i + 1], argv[0]);
+      i++;
+    } else if (argv[i][0] == '-' || config->output_folder != NULL) {
+      sweep_usage(argv[0]);
+    } else {
+      config->output_folder = argv[i];
+    }
+  }
+
+  // --repetitions alone also raises the maximum
+  if (config->timing.max_repetitions < config->timing.min_repetitions) {
+    config->timing.max_repetitions = config->timing.min_repetitions;
+  }
+  if (config->timing.warmup_runs < 0 || config->timing.min_repetitions < 1 ||
+      config->timing.max_repetitions > TIMING_MAX_SAMPLES || config->timing.target_ci < 0.0 ||
+      config->freivalds_trials < 0) {
+    sweep_usage(argv[0]);
+  }
+
+  if (config->scaling == SWEEP_SCALING_NONE) {
+    if (config->thread_count == 0) {
+      copy_list(threads, 1, config->threads, &config->thread_count);
+    }
+    return;
+  }
+  if (config->shape_count > 0) {
+    sweep_usage(argv[0]);
+  }
+  if (config->thread_count == 0) {
+    config->thread_count = scaling_thread_list(config->threads);
+  }
+  scaling_thread_order(config->threads, &config->thread_count);
+}
+
+static double *sweep_alloc(size_t rows, size_t cols, size_t *ld) {
+  const size_t row_multiple = MATRIX_ALIGNMENT / sizeof(double);
+  *ld = (cols + row_multiple - 1) / row_multiple * row_multiple;
+  void *buffer = NULL;
+  if (posix_memalign(&buffer, MATRIX_ALIGNMENT, rows * *ld * sizeof(double)) != 0) {
+    printf("Error: Failed to allocate memory for a %zu x %zu matrix\n", rows, cols);
+    exit(1);
+  }
+  return (double *)buffer;
+}
+
+// element (i, j) from the stream of key like matrix_fill_random_key, or 0
+// without a stream; written in parallel so the pages are spread like the
+// kernels touch them
+static void sweep_fill(double *data, size_t rows, size_t cols, size_t ld, uint64_t key, int random) {
+  const double range = UNIFORM_MAX - UNIFORM_MIN;
+#pragma omp parallel for schedule(static) default(none) shared(data, rows, cols, ld, key, random, range)
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t j = 0; j < ld; j++) {
+      data[i * ld + j] = (random && j < cols) ? UNIFORM_MIN + range * matrix_random_unit(key, i * cols + j) : 0.0;
+    }
+  }
+}
+
+// random A and B of the shape, one input pair per (seed, shape)
+static void sweep_problem_create(SweepProblem *p, SweepShape shape) {
+  uint64_t key = matrix_random_bits(~matrix_random_seed(), shape.m);
+  key = matrix_random_bits(key, shape.n);
+  key = matrix_random_bits(key, shape.k);
+
+  p->shape = shape;
+  p->A = sweep_alloc(shape.m, shape.k, &p->lda);
+  p->B = sweep_alloc(shape.k, shape.n, &p->ldb);
+  p->C = sweep_alloc(shape.m, shape.n, &p->ldc);
+  sweep_fill(p->A, shape.m, shape.k, p->lda, matrix_random_bits(key, 0), 1);
+  sweep_fill(p->B, shape.k, shape.n, p->ldb, matrix_random_bits(key, 1), 1);
+  sweep_fill(p->C, shape.m, shape.n, p->ldc, 0, 0);
+
+  const Matrix a = {p->A, (int)shape.m, p->lda, 0};
+  const Matrix b = {p->B, (int)shape.m, p->ldb, 0};
+  const Matrix c = {p->C, (int)shape.m, p->ldc, 0};
+  p->a = a;
+  p->b = b;
+  p->c = c;
+}
+
+static void sweep_problem_destroy(SweepProblem *p) {
+  free(p->A);
+  free(p->B);
+  free(p->C);
+}
+
+// times the kernel on the problem and checks the product; returns the
+// Freivalds verdict, or -1 when the check is skipped
+static int sweep_measure(const SweepConfig *config, const SweepKernel *kernel, SweepProblem *p, int thread_count,
+                         int parameter, TimingStats *stats) {
+  TIMING_WARMUP(&config->timing, kernel->run(p, kernel->variant, thread_count, parameter));
+  TIMING_REPEAT(&config->timing, stats, kernel->run(p, kernel->variant, thread_count, parameter));
+
+  const SweepShape s = p->shape;
+  if (config->freivalds_trials == 0) {
+    return -1;
+  }
+  return freivalds_validate_gemm(s.m, s.n, s.k, p->A, p->lda, p->B, p->ldb, p->C, p->ldc, config->freivalds_trials);
+}
+
+// the chunk or block sizes the kernel takes, or a single unused 0
+static int kernel_parameters(const SweepConfig *config, const SweepKernel *kernel, const int **parameters) {
+  static const int no_parameter[] = {0};
+  if (kernel->parameter == SWEEP_CHUNK) {
+    *parameters = config->chunks;
+    return config->chunk_count;
+  }
+  if (kernel->parameter == SWEEP_BLOCK) {
+    *parameters = config->blocks;
+    return config->block_count;
+  }
+  *parameters = no_parameter;
+  return 1;
+}
+
+static void sweep_point(const SweepConfig *config, const SweepKernel *kernel, SweepProblem *p, int thread_count,
+                        int parameter) {
+  TimingStats stats;
+  const int correct = sweep_measure(config, kernel, p, thread_count, parameter, &stats);
+
+  const SweepShape s = p->shape;
+
+  const Roofline *roofline = roofline_machine(thread_count);
+  const double gflops = gemm_flops(s.m, s.n, s.k) / stats.median * 1e-9;
+  const double attainable = roofline_attainable(roofline, gemm_intensity(s.m, s.n, s.k));
+
+  FILE *csv_file = open_csv_file(csv_sweep);
+  fprintf(csv_file, "%s,%zu,%zu,%zu,%d,%d,%.9f,%d,%d,%.9f,%.9f,%.9f,%.9f,%.3f,%.3f,%.2f,", kernel->name, s.m, s.n,
+          s.k, thread_count, parameter, stats.median, stats.runs, stats.outliers, stats.min, stats.mean,
+          stats.stddev, isinf(stats.ci95) ? 0.0 : stats.ci95, gflops, attainable, 100.0 * gflops / attainable);
+  if (correct >= 0) {
+    fprintf(csv_file, "%d", correct);
+  }
+  fprintf(csv_file, "\n");
+  fclose(csv_file);
+
+#ifdef DEBUG
+  printf("%sSweep - %s - %zux%zux%zu, threads: %d, %s: %d - median %f s (%d runs), %.2f GFLOP/s" RESET "\n",
+         (correct == 0) ? RED "INCORRECT - " : GREEN, kernel->name, s.m, s.n, s.k, thread_count,
+         parameter_names[kernel->parameter], parameter, stats.median, stats.runs, gflops);
+#endif
+}
+
+static void sweep_shape(const SweepConfig *config, SweepShape shape) {
+  const int square = shape.m == shape.n && shape.n == shape.k;
+  const int single_thread[] = {1};
+
+  SweepProblem problem;
+  sweep_problem_create(&problem, shape);
+
+  for (int i = 0; i < config->kernel_count; i++) {
+    const SweepKernel *kernel = &sweep_kernels[config->kernels[i]];
+    if (!square && !kernel->rectangular) {
+      continue;
+    }
+    const int *threads = kernel->parallel ? config->threads : single_thread;
+    const int thread_total = kernel->parallel ? config->thread_count : 1;
+    const int *parameters;
+    const int parameter_total = kernel_parameters(config, kernel, &parameters);
+
+    for (int t = 0; t < thread_total; t++) {
+      for (int q = 0; q < parameter_total; q++) {
+        sweep_point(config, kernel, &problem, threads[t], parameters[q]);
+      }
+    }
+  }
+
+  sweep_problem_destroy(&problem);
+}
+
+static const char *const scaling_names[] = {"NONE", "STRONG", "WEAK"};
+
+// one scaling mode from the base size n: every parallel kernel and chunk/block
+// size on every thread count, in ascending order so the one-thread run that
+// normalises the others comes first
+static void sweep_scaling(const SweepConfig *config, SweepScaling mode, int base_size) {
+  const Topology *topology = host_topology();
+  const int baseline_count = config->kernel_count * SWEEP_MAX_VALUES;
+  double *baseline_time = malloc((size_t)baseline_count * sizeof(double));
+  double *baseline_flops = malloc((size_t)baseline_count * sizeof(double));
+  if (baseline_time == NULL || baseline_flops == NULL) {
+    printf("Error: Failed to allocate memory for the scaling baselines\n");
+    exit(1);
+  }
+
+  for (int t = 0; t < config->thread_count; t++) {
+    const int p = config->threads[t];
+    const size_t n = (mode == SWEEP_SCALING_WEAK) ? (size_t)lround(base_size * cbrt((double)p)) : (size_t)base_size;
+    const SweepShape shape = {n, n, n};
+    const double flops = gemm_flops(n, n, n);
+
+    SweepProblem problem;
+    sweep_problem_create(&problem, shape);
+
+    for (int i = 0; i < config->kernel_count; i++) {
+      const SweepKernel *kernel = &sweep_kernels[config->kernels[i]];
+      if (!kernel->parallel) {
+        continue;
+      }
+      const int *parameters;
+      const int parameter_total = kernel_parameters(config, kernel, &parameters);
+
+      for (int q = 0; q < parameter_total; q++) {
+        TimingStats stats;
+        const int correct = sweep_measure(config, kernel, &problem, p, parameters[q], &stats);
+        double *t1 = &baseline_time[i * SWEEP_MAX_VALUES + q];
+        double *w1 = &baseline_flops[i * SWEEP_MAX_VALUES + q];
+        if (p == 1) {
+          *t1 = stats.median;
+          *w1 = flops;
+        }
+
+        // speedup on the work actually done, so the rounding of the weak
+        // sizes does not bias it; Karp-Flatt e = (1/S - 1/p) / (1 - 1/p)
+        const double speedup = (flops / *w1) * (*t1 / stats.median);
+        const double efficiency = speedup / p;
+
+        FILE *csv_file = open_csv_file(csv_scaling_suite);
+        fprintf(csv_file, "%s,%s,%d,%zu,%d,%d,%d,%d,%.9f,%d,%d,%.9f,%.3f,%.4f,%.4f,", scaling_names[mode],
+                kernel->name, base_size, n, p, topology->physical_cores, p > topology->physical_cores, parameters[q],
+                stats.median, stats.runs, stats.outliers, isinf(stats.ci95) ? 0.0 : stats.ci95,
+                flops / stats.median * 1e-9, speedup, efficiency);
+        if (p > 1) {
+          fprintf(csv_file, "%.6f", (1.0 / speedup - 1.0 / p) / (1.0 - 1.0 / p));
+        }
+        fprintf(csv_file, ",");
+        if (correct >= 0) {
+          fprintf(csv_file, "%d", correct);
+        }
+        fprintf(csv_file, "\n");
+        fclose(csv_file);
+
+#ifdef DEBUG
+        printf("%sScaling %s - %s - n %zu, threads: %d, %s: %d - speedup %.2f, efficiency %.1f%%" RESET "\n",
+               (correct == 0) ? RED "INCORRECT - " : GREEN, scaling_names[mode], kernel->name, n, p,
+               parameter_names[kernel->parameter], parameters[q], speedup, 100.0 * efficiency);
+#endif
+      }
+    }
+
+    sweep_problem_destroy(&problem);
+  }
+
+  free(baseline_time);
+  free(baseline_flops);
+}
+
+static void sweep_run_scaling(const SweepConfig *config) {
+  const Topology *topology = host_topology();
+  printf("Scaling suite: %d logical CPUs on %d physical cores (up to %d per core), %d package(s)\n",
+         topology->logical_cpus, topology->physical_cores, topology->smt_width, topology->packages);
+  if (omp_get_proc_bind() == omp_proc_bind_false && topology->smt_width > 1) {
+    printf("Warning: threads are not bound, so the first threads may share a core; run with OMP_PLACES=cores "
+           "OMP_PROC_BIND=spread\n");
+  }
+
+  for (int i = 0; i < config->size_count; i++) {
+    if (config->scaling != SWEEP_SCALING_WEAK) {
+      sweep_scaling(config, SWEEP_SCALING_STRONG, config->sizes[i]);
+    }
+    if (config->scaling != SWEEP_SCALING_STRONG) {
+      sweep_scaling(config, SWEEP_SCALING_WEAK, config->sizes[i]);
+    }
+  }
+}
+
+void sweep_run(const SweepConfig *config) {
+  if (config->scaling != SWEEP_SCALING_NONE) {
+    sweep_run_scaling(config);
+    return;
+  }
+  for (int i = 0; i < config->size_count; i++) {
+    const size_t n = (size_t)config->sizes[i];
+    const SweepShape shape = {n, n, n};
+    sweep_shape(config, shape);
+  }
+  for (int i = 0; i < config->shape_count; i++) {
+    sweep_shape(config, config->shapes[i]);
+  }
+}
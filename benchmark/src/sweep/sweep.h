@@ -0,0 +1,70 @@
+// ABOUTME: Runtime-configured sweep over kernels, matrix shapes, thread counts and chunk/block sizes
+// ABOUTME: Read from the command line and key = value config files instead of parameters.h
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "../benchmark/timing.h"
+#include <stddef.h>
+
+// longest list of any sweep dimension
+#define SWEEP_MAX_VALUES 256
+
+// C (m x n) = A (m x k) * B (k x n)
+typedef struct {
+  size_t m;
+  size_t n;
+  size_t k;
+} SweepShape;
+
+// strong scaling keeps the size fixed, weak scaling grows it with the thread
+// count p to n * cbrt(p), keeping the work per thread n^3 / p constant
+typedef enum { SWEEP_SCALING_NONE, SWEEP_SCALING_STRONG, SWEEP_SCALING_WEAK, SWEEP_SCALING_BOTH } SweepScaling;
+
+typedef struct {
+  const char *output_folder;
+  int kernels[SWEEP_MAX_VALUES]; // indices into the kernel table of sweep.c
+  int kernel_count;
+  int sizes[SWEEP_MAX_VALUES]; // square products
+  int size_count;
+  SweepShape shapes[SWEEP_MAX_VALUES]; // m x n x k products, after the sizes
+  int shape_count;
+  int threads[SWEEP_MAX_VALUES]; // used by the parallel kernels only
+  int thread_count;
+  int chunks[SWEEP_MAX_VALUES]; // used by the kernels taking a chunk size
+  int chunk_count;
+  int blocks[SWEEP_MAX_VALUES]; // used by the kernels taking a block size
+  int block_count;
+  TimingPolicy timing;
+  int freivalds_trials; // 0 skips the validation
+  SweepScaling scaling;
+} SweepConfig;
+
+// command line of the sweep executable, the options applied in order:
+//   [--config FILE] [--kernels LIST] [--sizes LIST] [--shapes LIST]
+//   [--threads LIST] [--chunks LIST] [--blocks LIST] [--warmup N]
+//   [--repetitions N] [--max-repetitions N] [--target-ci X] [--trials N]
+//   [--scaling strong|weak|both] [--list-kernels] [output_folder]
+// A config file holds the same options as "name = value" lines (# starts a
+// comment, "output" names the output folder), so options after --config
+// override it. Integer lists are comma separated values and ranges: a:b:s
+// steps by s, a:b:*f multiplies by f, and "max" is omp_get_num_procs().
+// --sizes lists square sizes, --shapes MxNxK products, on which only the
+// kernels taking rectangular operands run. --kernels takes the names printed
+// by --list-kernels, or "all". --trials 0 skips the Freivalds check of the
+// products. --scaling turns the sweep into the scaling suite: the parallel
+// kernels run on every thread count, always including 1 as the baseline, with
+// --sizes as the fixed (strong) or one-thread (weak) sizes; it takes no
+// --shapes. Defaults come from parameters.h: all kernels on MATRIX_SIZES with
+// THREAD_COUNT threads (powers of two up to the physical cores, then up to
+// every logical CPU, under --scaling), CHUNK_SIZES, BLOCK_SIZES, the timing
+// policy and FREIVALDS_TRIALS
+void sweep_parse_args(int argc, char *argv[], SweepConfig *config);
+
+// runs every kernel on every shape, thread count and chunk/block size of the
+// config and appends one row per point to sweep.csv, or with --scaling one row
+// per point to scaling_suite.csv with the speedup, parallel efficiency and
+// Karp-Flatt serial fraction against the kernel's own one-thread run
+void sweep_run(const SweepConfig *config);
+
+#endif // SWEEP_H
@@ -1,35 +1,50 @@
 #include "mm_tiled_parallel.h"
+#include "../../gemm/gemm.h"
+#include "../tile_map.h"
 #include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 double parallel_multiply_tiled_tasks(const Matrix *restrict a,
                                      const Matrix *restrict b,
                                      Matrix *restrict c, int thread_count,
                                      int block_size) {
+  const size_t n = (size_t)a->size;
+  GemmBlocking blocking;
+  gemm_blocking_select(block_size, &blocking);
+  if (block_size == BLOCK_SIZE_AUTO) {
+    gemm_blocking_balance(&blocking, n, n, thread_count);
+  }
+  const size_t mc = blocking.mc, kc = blocking.kc, nc = blocking.nc;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  size_t block_i, block_j, block_k, i, j, k;
   matrix_fill_zero(c);
-  int n = a->size;
-  int block_i, block_j, block_k, i, j, k;
   double temp;
 
   double start = omp_get_wtime();
 
 #pragma omp parallel num_threads(thread_count), default(none),                 \
     private(temp, block_i, block_j, block_k, i, j, k),                         \
-    shared(a, b, c, block_size, n)
+    shared(A, B, C, lda, ldb, ldc, mc, kc, nc, n)
   {
 #pragma omp single
-    for (block_i = 0; block_i < n; block_i += block_size) {
-      for (block_j = 0; block_j < n; block_j += block_size) {
-        for (block_k = 0; block_k < n; block_k += block_size) {
-          int i_end = (block_i + block_size > n) ? n : (block_i + block_size);
-          int j_end = (block_j + block_size > n) ? n : (block_j + block_size);
-          int k_end = (block_k + block_size > n) ? n : (block_k + block_size);
+    for (block_i = 0; block_i < n; block_i += mc) {
+      for (block_j = 0; block_j < n; block_j += nc) {
+        size_t i_end = (block_i + mc > n) ? n : (block_i + mc);
+        size_t j_end = (block_j + nc > n) ? n : (block_j + nc);
+        // the task owns this C tile across the whole k range, so its
+        // updates need no atomics and the tile stays in cache between blocks
 #pragma omp task
+        for (block_k = 0; block_k < n; block_k += kc) {
+          size_t k_end = (block_k + kc > n) ? n : (block_k + kc);
           for (i = block_i; i < i_end; i++) {
             for (k = block_k; k < k_end; k++) {
-              temp = a->data[i][k];
+              temp = A[i * lda + k];
               for (j = block_j; j < j_end; j++) {
-#pragma omp atomic
-                c->data[i][j] += temp * b->data[k][j];
+                C[i * ldc + j] += temp * B[k * ldb + j];
               }
             }
           }
@@ -44,29 +59,187 @@ double parallel_multiply_tiled_tasks(const Matrix *restrict a,
 double parallel_multiply_tiled(const Matrix *restrict a,
                                const Matrix *restrict b, Matrix *restrict c,
                                int thread_count, int block_size) {
+  const size_t n = (size_t)a->size;
+  GemmBlocking blocking;
+  gemm_blocking_select(block_size, &blocking);
+  if (block_size == BLOCK_SIZE_AUTO) {
+    gemm_blocking_balance(&blocking, n, n, thread_count);
+  }
+  const size_t mc = blocking.mc, kc = blocking.kc, nc = blocking.nc;
+  const size_t tiles_i = (n + mc - 1) / mc, tiles_j = (n + nc - 1) / nc;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  size_t tile_i, tile_j, block_k, i, j, k;
   matrix_fill_zero(c);
-  int n = a->size;
-  int block_i, block_j, block_k, i, j, k;
   double temp;
 
   double start = omp_get_wtime();
 
 #pragma omp parallel num_threads(thread_count), default(none),                 \
-    private(temp, block_i, block_j, block_k, i, j, k),                         \
-    shared(a, b, c, block_size, n)
+    private(temp, tile_i, tile_j, block_k, i, j, k),                           \
+    shared(A, B, C, lda, ldb, ldc, mc, kc, nc, n, tiles_i, tiles_j)
+  {
+    // distribute the 2D grid of C tiles, not just the rows of tiles
+#pragma omp for collapse(2) schedule(static)
+    for (tile_i = 0; tile_i < tiles_i; tile_i++) {
+      for (tile_j = 0; tile_j < tiles_j; tile_j++) {
+        size_t block_i = tile_i * mc, block_j = tile_j * nc;
+        size_t i_end = (block_i + mc > n) ? n : (block_i + mc);
+        size_t j_end = (block_j + nc > n) ? n : (block_j + nc);
+        for (block_k = 0; block_k < n; block_k += kc) {
+          size_t k_end = (block_k + kc > n) ? n : (block_k + kc);
+          for (i = block_i; i < i_end; i++) {
+            for (k = block_k; k < k_end; k++) {
+              temp = A[i * lda + k];
+              for (j = block_j; j < j_end; j++) {
+                C[i * ldc + j] += temp * B[k * ldb + j];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  return omp_get_wtime() - start;
+}
+
+double parallel_multiply_tiled_ksplit(const Matrix *restrict a,
+                                      const Matrix *restrict b,
+                                      Matrix *restrict c, int thread_count,
+                                      int block_size) {
+  const size_t n = (size_t)a->size;
+  GemmBlocking blocking;
+  gemm_blocking_select(block_size, &blocking);
+  const size_t mc = blocking.mc, kc = blocking.kc, nc = blocking.nc;
+  const size_t tiles_i = (n + mc - 1) / mc, tiles_j = (n + nc - 1) / nc;
+  const size_t tiles = tiles_i * tiles_j;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+
+  // replicate the tile grid along k until there is a work item per thread;
+  // split s accumulates k blocks s, s + splits, ... into its own copy of C
+  const size_t k_blocks = (n + kc - 1) / kc;
+  size_t splits = ((size_t)thread_count + tiles - 1) / tiles;
+  if (splits > k_blocks) {
+    splits = k_blocks;
+  }
+  if (splits == 0) {
+    splits = 1;
+  }
+  const size_t plane = n * ldc;
+  double *partial = NULL;
+  if (splits > 1) {
+    partial = malloc((splits - 1) * plane * sizeof(double));
+    if (partial == NULL) {
+      printf("Error: Failed to allocate memory for partial C buffers\n");
+      exit(1);
+    }
+  }
+  size_t split, tile, block_k, i, j, k;
+  matrix_fill_zero(c);
+  double temp;
+
+  double start = omp_get_wtime();
+
+#pragma omp parallel num_threads(thread_count), default(none),                 \
+    private(temp, split, tile, block_k, i, j, k),                              \
+    shared(A, B, C, partial, plane, splits, lda, ldb, ldc, mc, kc, nc, n,      \
+           tiles, tiles_j)
   {
 #pragma omp for schedule(static)
-    for (block_i = 0; block_i < n; block_i += block_size) {
-      for (block_j = 0; block_j < n; block_j += block_size) {
-        for (block_k = 0; block_k < n; block_k += block_size) {
-          int i_end = (block_i + block_size > n) ? n : (block_i + block_size);
-          int j_end = (block_j + block_size > n) ? n : (block_j + block_size);
-          int k_end = (block_k + block_size > n) ? n : (block_k + block_size);
+    for (i = 0; i < (splits - 1) * plane; i++) {
+      partial[i] = 0.0;
+    }
+
+#pragma omp for collapse(2) schedule(static)
+    for (split = 0; split < splits; split++) {
+      for (tile = 0; tile < tiles; tile++) {
+        double *restrict dst = (split == 0) ? C : &partial[(split - 1) * plane];
+        size_t block_i = tile / tiles_j * mc, block_j = tile % tiles_j * nc;
+        size_t i_end = (block_i + mc > n) ? n : (block_i + mc);
+        size_t j_end = (block_j + nc > n) ? n : (block_j + nc);
+        for (block_k = split * kc; block_k < n; block_k += splits * kc) {
+          size_t k_end = (block_k + kc > n) ? n : (block_k + kc);
           for (i = block_i; i < i_end; i++) {
             for (k = block_k; k < k_end; k++) {
-              temp = a->data[i][k];
+              temp = A[i * lda + k];
               for (j = block_j; j < j_end; j++) {
-                c->data[i][j] += temp * b->data[k][j];
+                dst[i * ldc + j] += temp * B[k * ldb + j];
+              }
+            }
+          }
+        }
+      }
+    }
+
+    // parallel reduction of the partial products into C, row by row
+#pragma omp for schedule(static)
+    for (i = 0; i < n; i++) {
+      for (split = 1; split < splits; split++) {
+        const double *restrict src = &partial[(split - 1) * plane];
+        for (j = 0; j < n; j++) {
+          C[i * ldc + j] += src[i * ldc + j];
+        }
+      }
+    }
+  }
+
+  double result = omp_get_wtime() - start;
+  free(partial);
+  return result;
+}
+
+double parallel_multiply_tiled_packed(const Matrix *restrict a,
+                                      const Matrix *restrict b,
+                                      Matrix *restrict c, int thread_count,
+                                      int block_size) {
+  const size_t n = (size_t)a->size;
+  GemmBlocking blocking;
+  gemm_blocking_select(block_size, &blocking);
+  // B panels always span the host-derived L3 width
+  blocking.nc = gemm_host_blocking()->nc;
+
+  double start = omp_get_wtime();
+
+  // beta = 0 clears C inside the engine, block by block
+  dgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, n, n, n, 1.0, a->data, a->ld, b->data,
+        b->ld, 0.0, c->data, c->ld, &blocking, thread_count);
+
+  return omp_get_wtime() - start;
+}
+
+double parallel_multiply_tiled_morton(const MortonMatrix *restrict a,
+                                      const MortonMatrix *restrict b,
+                                      MortonMatrix *restrict c,
+                                      int thread_count) {
+  const size_t tile = c->tile, used = MORTON_USED_TILES(c);
+  size_t tile_i, tile_j, tile_k, i, j, k;
+  morton_fill_zero(c);
+  double temp;
+
+  double start = omp_get_wtime();
+
+#pragma omp parallel num_threads(thread_count), default(none),                 \
+    private(temp, tile_i, tile_j, tile_k, i, j, k), shared(a, b, c, tile, used)
+  {
+#pragma omp for collapse(2) schedule(static)
+    for (tile_i = 0; tile_i < used; tile_i++) {
+      for (tile_j = 0; tile_j < used; tile_j++) {
+        double *restrict C = MORTON_TILE(c, tile_i, tile_j);
+        for (tile_k = 0; tile_k < used; tile_k++) {
+          // both operand tiles are contiguous and zero padded, so every
+          // tile is a full tile x tile product
+          const double *restrict A = MORTON_TILE(a, tile_i, tile_k);
+          const double *restrict B = MORTON_TILE(b, tile_k, tile_j);
+          for (i = 0; i < tile; i++) {
+            for (k = 0; k < tile; k++) {
+              temp = A[i * tile + k];
+              for (j = 0; j < tile; j++) {
+                C[i * tile + j] += temp * B[k * tile + j];
               }
             }
           }
@@ -74,5 +247,100 @@ double parallel_multiply_tiled(const Matrix *restrict a,
       }
     }
   }
+
   return omp_get_wtime() - start;
 }
+
+// a C tile and the number of its k blocks where both A and B tiles are nonzero
+typedef struct {
+  size_t tile;
+  size_t products;
+} SparseTile;
+
+static int compare_products_desc(const void *x, const void *y) {
+  const SparseTile *p = x, *q = y;
+  return (p->products < q->products) - (p->products > q->products);
+}
+
+double parallel_multiply_tiled_sparse(const Matrix *restrict a,
+                                      const Matrix *restrict b,
+                                      Matrix *restrict c, int thread_count,
+                                      int block_size, size_t *skipped) {
+  const size_t n = (size_t)a->size;
+  GemmBlocking blocking;
+  gemm_blocking_select(block_size, &blocking);
+  if (block_size == BLOCK_SIZE_AUTO) {
+    gemm_blocking_balance(&blocking, n, n, thread_count);
+  }
+  const size_t mc = blocking.mc, kc = blocking.kc, nc = blocking.nc;
+  const size_t tiles_i = (n + mc - 1) / mc, tiles_j = (n + nc - 1) / nc;
+  const size_t k_blocks = (n + kc - 1) / kc;
+  const size_t lda = a->ld, ldb = b->ld, ldc = c->ld;
+  const double *restrict A = a->data;
+  const double *restrict B = b->data;
+  double *restrict C = c->data;
+  TileMap map_a, map_b;
+  SparseTile *work = malloc(tiles_i * tiles_j * sizeof(SparseTile));
+  if (work == NULL) {
+    printf("Error: Failed to allocate memory for sparse work list\n");
+    exit(1);
+  }
+  size_t work_count = 0, products = 0, item, block_k, i, j, k;
+  matrix_fill_zero(c);
+  double temp;
+
+  double start = omp_get_wtime();
+
+  tile_map_build(&map_a, a, mc, kc);
+  tile_map_build(&map_b, b, kc, nc);
+
+  // keep only the C tiles with work, largest first
+  for (size_t tile = 0; tile < tiles_i * tiles_j; tile++) {
+    size_t tile_i = tile / tiles_j, tile_j = tile % tiles_j, count = 0;
+    for (size_t kb = 0; kb < k_blocks; kb++) {
+      count += (size_t)(tile_map_get(&map_a, tile_i, kb) &&
+                        tile_map_get(&map_b, kb, tile_j));
+    }
+    if (count > 0) {
+      work[work_count].tile = tile;
+      work[work_count].products = count;
+      work_count++;
+      products += count;
+    }
+  }
+  qsort(work, work_count, sizeof(SparseTile), compare_products_desc);
+
+#pragma omp parallel for num_threads(thread_count), default(none),             \
+    private(temp, item, block_k, i, j, k),                                     \
+    shared(A, B, C, lda, ldb, ldc, mc, kc, nc, n, tiles_j, map_a, map_b, work, \
+           work_count) schedule(dynamic, 1)
+  for (item = 0; item < work_count; item++) {
+    size_t block_i = work[item].tile / tiles_j * mc;
+    size_t block_j = work[item].tile % tiles_j * nc;
+    size_t i_end = (block_i + mc > n) ? n : (block_i + mc);
+    size_t j_end = (block_j + nc > n) ? n : (block_j + nc);
+    for (block_k = 0; block_k < n; block_k += kc) {
+      if (!tile_map_get(&map_a, block_i / mc, block_k / kc) ||
+          !tile_map_get(&map_b, block_k / kc, block_j / nc)) {
+        continue;
+      }
+      size_t k_end = (block_k + kc > n) ? n : (block_k + kc);
+      for (i = block_i; i < i_end; i++) {
+        for (k = block_k; k < k_end; k++) {
+          temp = A[i * lda + k];
+          for (j = block_j; j < j_end; j++) {
+            C[i * ldc + j] += temp * B[k * ldb + j];
+          }
+        }
+      }
+    }
+  }
+
+  double result = omp_get_wtime() - start;
+
+  tile_map_destroy(&map_a);
+  tile_map_destroy(&map_b);
+  free(work);
+  *skipped = tiles_i * tiles_j * k_blocks - products;
+  return result;
+}
@@ -4,11 +4,35 @@
 #ifndef MM_TILED_PARALLEL_H
 #define MM_TILED_PARALLEL_H
 
+#include "../../gemm/blocking.h"
 #include "../../matrix/matrix.h"
+#include "../../matrix/matrix_morton.h"
 
+// distributes the 2D grid of C tiles over the team
 double parallel_multiply_tiled(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c, int thread_count,
                                int block_size);
 
+// 2.5D: when there are fewer C tiles than threads the k range is split as well,
+// each split accumulating into its own partial C that is reduced in parallel
+double parallel_multiply_tiled_ksplit(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                                      int thread_count, int block_size);
+
 double parallel_multiply_tiled_tasks(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
                                      int thread_count, int block_size);
+
+// packed-panel engine: B panels are packed once and shared by the team, each
+// thread packs its own block of A
+double parallel_multiply_tiled_packed(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                                      int thread_count, int block_size);
+
+// block-sparse: C tiles are ordered by their number of nonzero tile products,
+// largest first, and handed out dynamically so the skipped products do not
+// leave threads idle. Time and *skipped as in serial_multiply_tiled_sparse
+double parallel_multiply_tiled_sparse(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                                      int thread_count, int block_size, size_t *skipped);
+
+// 2D grid of C tiles on the Z-order layout, the tile size is the one the
+// matrices were created with
+double parallel_multiply_tiled_morton(const MortonMatrix *restrict a, const MortonMatrix *restrict b,
+                                      MortonMatrix *restrict c, int thread_count);
 #endif // MM_TILED_PARALLEL_H
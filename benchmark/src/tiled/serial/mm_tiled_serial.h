@@ -4,8 +4,21 @@
 #ifndef MM_TILED_SERIAL_H
 #define MM_TILED_SERIAL_H
 
+#include "../../gemm/blocking.h"
 #include "../../matrix/matrix.h"
 
+// block_size == BLOCK_SIZE_AUTO blocks i/k/j by the host-derived mc/kc/nc
 double serial_multiply_tiled(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c, int block_size);
 
+// mc x kc blocks of A and kc x nc panels of B are packed into contiguous
+// micro-kernel ordered buffers before computing; block_size overrides mc and kc
+double serial_multiply_tiled_packed(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                                    int block_size);
+
+// block-sparse: a pre-pass maps the nonzero mc x kc tiles of A and kc x nc
+// tiles of B, and products with a zero tile are skipped. The pre-pass is part
+// of the returned time; *skipped receives the number of skipped tile products
+double serial_multiply_tiled_sparse(const Matrix *restrict a, const Matrix *restrict b, Matrix *restrict c,
+                                    int block_size, size_t *skipped);
+
 #endif // MM_TILED_SERIAL_H
@@ -0,0 +1,48 @@
+#include "tile_map.h"
+
+static int tile_is_nonzero(const Matrix *restrict matrix, size_t row, size_t col, size_t rows, size_t cols) {
+  const size_t ld = matrix->ld;
+  const double *restrict data = matrix->data;
+  for (size_t i = row; i < row + rows; i++) {
+    for (size_t j = col; j < col + cols; j++) {
+      if (data[i * ld + j] != 0.0) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+void tile_map_build(TileMap *map, const Matrix *restrict matrix, size_t tile_rows, size_t tile_cols) {
+  const size_t n = (size_t)matrix->size;
+  map->rows = (n + tile_rows - 1) / tile_rows;
+  map->cols = (n + tile_cols - 1) / tile_cols;
+  map->words_per_row = (map->cols + 63) / 64;
+  map->bits = calloc(map->rows * map->words_per_row + 1, sizeof(uint64_t));
+  if (map->bits == NULL) {
+    printf("Error: Failed to allocate memory for tile map\n");
+    exit(1);
+  }
+
+  const size_t rows = map->rows, cols = map->cols, words = map->words_per_row;
+  uint64_t *bits = map->bits;
+  // a thread owns whole rows of tiles, and so whole words of the bitmap
+#pragma omp parallel for schedule(dynamic), default(none),                     \
+    shared(matrix, n, tile_rows, tile_cols, rows, cols, words, bits)
+  for (size_t ti = 0; ti < rows; ti++) {
+    size_t row = ti * tile_rows;
+    size_t height = (row + tile_rows > n) ? n - row : tile_rows;
+    for (size_t tj = 0; tj < cols; tj++) {
+      size_t col = tj * tile_cols;
+      size_t width = (col + tile_cols > n) ? n - col : tile_cols;
+      if (tile_is_nonzero(matrix, row, col, height, width)) {
+        bits[ti * words + tj / 64] |= (uint64_t)1 << (tj % 64);
+      }
+    }
+  }
+}
+
+void tile_map_destroy(TileMap *map) {
+  free(map->bits);
+  map->bits = NULL;
+}
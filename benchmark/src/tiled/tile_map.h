@@ -0,0 +1,26 @@
+// ABOUTME: Per-tile nonzero bitmap of a matrix, built in one parallel pre-pass
+// ABOUTME: Lets the tiled kernels skip products with an all-zero tile of A or B
+
+#ifndef TILE_MAP_H
+#define TILE_MAP_H
+
+#include "../matrix/matrix.h"
+#include <stdint.h>
+
+// bit (ti, tj) is set when the tile_rows x tile_cols tile at (ti, tj) has a
+// nonzero element; every row of tiles starts on a new 64-bit word
+typedef struct {
+  uint64_t *bits;
+  size_t rows;
+  size_t cols;
+  size_t words_per_row;
+} TileMap;
+
+static inline int tile_map_get(const TileMap *map, size_t ti, size_t tj) {
+  return (int)((map->bits[ti * map->words_per_row + tj / 64] >> (tj % 64)) & 1);
+}
+
+void tile_map_build(TileMap *map, const Matrix *restrict matrix, size_t tile_rows, size_t tile_cols);
+void tile_map_destroy(TileMap *map);
+
+#endif // TILE_MAP_H
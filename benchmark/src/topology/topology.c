@@ -0,0 +1,95 @@
+#define _GNU_SOURCE
+
+#include "topology.h"
+#include <omp.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static Topology host;
+static int host_detected = 0;
+
+// /sys/devices/system/cpu/cpu<cpu>/topology/<name>, or -1
+static int sysfs_topology_id(int cpu, const char *name) {
+  char path[128];
+  int value = -1;
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    return -1;
+  }
+  if (fscanf(file, "%d", &value) != 1) {
+    value = -1;
+  }
+  fclose(file);
+  return value;
+}
+
+static void detect_topology(void) {
+  int cpus[CPU_SETSIZE];
+  int cpu_count = 0;
+
+  cpu_set_t mask;
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &mask)) {
+        cpus[cpu_count++] = cpu;
+      }
+    }
+  }
+  if (cpu_count == 0) {
+    cpu_count = (omp_get_num_procs() < CPU_SETSIZE) ? omp_get_num_procs() : CPU_SETSIZE;
+    for (int cpu = 0; cpu < cpu_count; cpu++) {
+      cpus[cpu] = cpu;
+    }
+  }
+
+  // (package, core) of every CPU; unreadable ids become unique negative ones
+  int *package_ids = malloc((size_t)cpu_count * sizeof(int));
+  int *core_ids = malloc((size_t)cpu_count * sizeof(int));
+  if (package_ids == NULL || core_ids == NULL) {
+    printf("Error: Failed to allocate memory for the topology\n");
+    exit(1);
+  }
+  for (int i = 0; i < cpu_count; i++) {
+    package_ids[i] = sysfs_topology_id(cpus[i], "physical_package_id");
+    core_ids[i] = sysfs_topology_id(cpus[i], "core_id");
+    if (package_ids[i] < 0 || core_ids[i] < 0) {
+      package_ids[i] = -1;
+      core_ids[i] = -1 - i;
+    }
+  }
+
+  host.logical_cpus = cpu_count;
+  host.physical_cores = 0;
+  host.packages = 0;
+  host.smt_width = 1;
+  for (int i = 0; i < cpu_count; i++) {
+    int first_of_core = 1, first_of_package = 1, siblings = 0;
+    for (int j = 0; j < cpu_count; j++) {
+      const int same_package = package_ids[j] == package_ids[i];
+      if (same_package && core_ids[j] == core_ids[i]) {
+        siblings++;
+        first_of_core = first_of_core && j >= i;
+      }
+      first_of_package = first_of_package && (j >= i || !same_package);
+    }
+    host.physical_cores += first_of_core;
+    host.packages += first_of_package;
+    host.smt_width = (siblings > host.smt_width) ? siblings : host.smt_width;
+  }
+
+  free(package_ids);
+  free(core_ids);
+}
+
+const Topology *host_topology(void) {
+#pragma omp critical(topology_detect)
+  {
+    if (!host_detected) {
+      detect_topology();
+      host_detected = 1;
+    }
+  }
+  return &host;
+}
@@ -0,0 +1,18 @@
+// ABOUTME: Processor topology of the CPUs this process may run on, read from sysfs
+// ABOUTME: Separates physical cores from their SMT siblings for the scaling suite
+
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+typedef struct {
+  int logical_cpus;   // CPUs in the affinity mask, omp_get_num_procs()
+  int physical_cores; // distinct (package, core) pairs among them
+  int packages;       // distinct sockets among them
+  int smt_width;      // most logical CPUs sharing one core
+} Topology;
+
+// detected on first use and cached; a CPU whose sysfs topology cannot be read
+// counts as a core of its own, so without sysfs every CPU is a physical core
+const Topology *host_topology(void);
+
+#endif // TOPOLOGY_H
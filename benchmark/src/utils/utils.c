@@ -2,6 +2,8 @@
 // ABOUTME: CSV writing and benchmarking data output helpers
 
 #include "utils.h"
+#include "../gemm/gemm.h"
+#include "../main/parameters.h"
 #include <limits.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,7 +12,7 @@
 static char *output_folder = NULL;
 
 CSV_DATA csv_serial_permutations = {
-    .header = "MATRIX_SIZE,IJK,IKJ,JIK,JKI,KIJ,KJI",
+    .header = "MATRIX_SIZE,IJK,IKJ,JIK,JKI,KIJ,KJI,BASELINE_CACHED",
     .filename = "serial_permutations.csv",
 };
 
@@ -20,21 +22,72 @@ CSV_DATA csv_parallel_permutations = {
 };
 
 CSV_DATA csv_serial_parallel_scaling_classic = {
-    .header = "MATRIX_SIZE,CHUNK,SERIAL_BASELINE,P2T,P4T,P8T",
+    .header = "MATRIX_SIZE,CHUNK,SERIAL_BASELINE,P2T,P4T,P8T,BASELINE_CACHED",
     .filename = "serial_parallel_scaling_classic.csv",
 };
 
 CSV_DATA csv_serial_parallel_scaling_improved = {
-    .header = "MATRIX_SIZE,CHUNK,SERIAL_BASELINE,P2T,P4T,P8T",
+    .header = "MATRIX_SIZE,CHUNK,SERIAL_BASELINE,P2T,P4T,P8T,BASELINE_CACHED",
     .filename = "serial_parallel_scaling_improved.csv",
 };
 
 CSV_DATA csv_tiled = {
     .header = "MATRIX_SIZE,THREADS,BLOCK_SIZE,SERIAL_IKJ,PARALLEL_IKJ,SERIAL_"
-              "TILED,PARALLEL_TILED,PARALLEL_TILED_TASKS",
+              "TILED,PARALLEL_TILED,PARALLEL_TILED_TASKS,SERIAL_TILED_PACKED,"
+              "PARALLEL_TILED_PACKED,PARALLEL_TILED_KSPLIT,STRASSEN,PARALLEL_"
+              "RECURSIVE,PARALLEL_TILED_MORTON,PARALLEL_RECURSIVE_MORTON,"
+              "ADAPTIVE_TILED,SERIAL_TILED_PACKED_GFLOPS,PARALLEL_TILED_PACKED_GFLOPS,"
+              "MICROKERNEL,STRASSEN_MEM_MB,STRASSEN_MAX_ERROR,TILED_MORTON_"
+              "CONVERT_TIME,RECURSIVE_MORTON_CONVERT_TIME,BASELINE_CACHED",
     .filename = "tiled.csv",
 };
 
+CSV_DATA csv_sparse = {
+    .header = "MATRIX_SIZE,THREADS,BLOCK_SIZE,BANDWIDTH,SERIAL_TILED,PARALLEL_"
+              "TILED,SERIAL_TILED_SPARSE,PARALLEL_TILED_SPARSE,SERIAL_SKIPPED_"
+              "PRODUCTS,PARALLEL_SKIPPED_PRODUCTS",
+    .filename = "sparse.csv",
+};
+
+CSV_DATA csv_streaming = {
+    .header = "MATRIX_SIZE,THREADS,MEMORY_BUDGET_MB,PANEL_ROWS,TIME,GFLOPS,"
+              "MAX_SAMPLE_ERROR",
+    .filename = "streaming.csv",
+};
+
+CSV_DATA csv_kernel_metrics = {
+    .header = "BENCHMARK,KERNEL,MATRIX_SIZE,THREADS,PARAMETER,TIME,RUNS,"
+              "OUTLIERS,MIN_TIME,MEAN_TIME,STDDEV_TIME,CI95_TIME,CYCLES,"
+              "INSTRUCTIONS,L1D_MISSES,LLC_MISSES,DTLB_MISSES,FP_OPS,GFLOPS,"
+              "INTENSITY,MEASURED_INTENSITY,ROOFLINE_GFLOPS,ROOFLINE_PERCENT",
+    .filename = "kernel_metrics.csv",
+};
+
+CSV_DATA csv_roofline = {
+    .header = "THREADS,PEAK_GFLOPS,BANDWIDTH_GBS,PEAK_KERNEL",
+    .filename = "roofline.csv",
+};
+
+CSV_DATA csv_sweep = {
+    .header = "KERNEL,M,N,K,THREADS,PARAMETER,TIME,RUNS,OUTLIERS,MIN_TIME,"
+              "MEAN_TIME,STDDEV_TIME,CI95_TIME,GFLOPS,ROOFLINE_GFLOPS,"
+              "ROOFLINE_PERCENT,CORRECT",
+    .filename = "sweep.csv",
+};
+
+CSV_DATA csv_scaling_suite = {
+    .header = "MODE,KERNEL,BASE_SIZE,MATRIX_SIZE,THREADS,PHYSICAL_CORES,SMT,"
+              "PARAMETER,TIME,RUNS,OUTLIERS,CI95_TIME,GFLOPS,SPEEDUP,"
+              "EFFICIENCY,KARP_FLATT,CORRECT",
+    .filename = "scaling_suite.csv",
+};
+
+CSV_DATA csv_batched = {
+    .header = "MATRIX_SIZE,BATCH_COUNT,THREADS,PARALLEL_IKJ_LOOP,BATCHED,"
+              "BATCHED_STRIDED,ADAPTIVE_IKJ_LOOP",
+    .filename = "batched.csv",
+};
+
 void set_output_folder(const char *folder_name) {
   if (output_folder != NULL) {
     free(output_folder);
@@ -144,19 +197,275 @@ void clear_csv_file(CSV_DATA csv_data) {
   fclose(csv_file);
 }
 
-void usage(char *program_name) {
-  printf("Usage: %s <matrix_size> <thread_count> <chunk_size>\n", program_name);
-  printf("Chunk: The chunk size for the parallel loop permutations\n");
+static void benchmark_usage(char *program_name) {
+  printf("Usage: %s [--a FILE --b FILE [--c FILE]] "
+         "[--validate reference|freivalds] [--trials N] [--reference-cache DIR] "
+         "[--counters] [--warmup N] [--repetitions N] [--max-repetitions N] "
+         "[--target-ci X] [--seed N] [output_folder]\n",
+         program_name);
+  printf("--a/--b: read the input matrices from binary matrix files\n");
+  printf("--c: write the product A * B to a binary matrix file\n");
+  printf("--validate: compare the products with the baseline product "
+         "(default) or check them with Freivalds' test\n");
+  printf("--trials: Freivalds trials per product (default %d)\n",
+         FREIVALDS_TRIALS);
+  printf("--reference-cache: keep the serial baseline products and times in "
+         "DIR, keyed by size and seed (generated inputs only); later runs hit "
+         "it only with the same --seed\n");
+  printf("--counters: add the hardware counters of every kernel run to "
+         "kernel_metrics.csv\n");
+  printf("--warmup: untimed runs of every kernel (default %d)\n",
+         WARMUP_RUNS);
+  printf("--repetitions/--max-repetitions: measured runs of every kernel "
+         "(default %d to %d, at most %d)\n",
+         REPETITIONS, MAX_REPETITIONS, TIMING_MAX_SAMPLES);
+  printf("--target-ci: stop repeating once the 95%% confidence interval of "
+         "the mean time is within this fraction of it (default %g, 0 = "
+         "never)\n",
+         TARGET_CI);
+  printf("--seed: seed of the generated inputs (default SEED, the time)\n");
   exit(1);
 }
 
-void get_args(int argc, char *argv[], int *matrix_size, int *thread_count,
-              int *chunk_size) {
-  if (argc != 4) {
-    usage(argv[0]);
+void get_benchmark_args(int argc, char *argv[], BenchmarkArgs *args) {
+  args->output_folder = NULL;
+  args->a_path = NULL;
+  args->b_path = NULL;
+  args->c_path = NULL;
+  args->reference_cache = NULL;
+  args->counters = 0;
+  args->validation = VALIDATE_REFERENCE;
+  args->freivalds_trials = FREIVALDS_TRIALS;
+  args->timing.warmup_runs = WARMUP_RUNS;
+  args->timing.min_repetitions = REPETITIONS;
+  args->timing.max_repetitions = MAX_REPETITIONS;
+  args->timing.target_ci = TARGET_CI;
+
+  for (int i = 1; i < argc; i++) {
+    const char **target = NULL;
+    if (strcmp(argv[i], "--validate") == 0 && i + 1 < argc) {
+      const char *mode = argv[++i];
+      if (strcmp(mode, "reference") == 0) {
+        args->validation = VALIDATE_REFERENCE;
+      } else if (strcmp(mode, "freivalds") == 0) {
+        args->validation = VALIDATE_FREIVALDS;
+      } else {
+        benchmark_usage(argv[0]);
+      }
+      continue;
+    } else if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+      args->freivalds_trials = atoi(argv[++i]);
+      if (args->freivalds_trials < 1) {
+        benchmark_usage(argv[0]);
+      }
+      continue;
+    } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+      args->timing.warmup_runs = atoi(argv[++i]);
+      if (args->timing.warmup_runs < 0) {
+        benchmark_usage(argv[0]);
+      }
+      continue;
+    } else if (strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+      args->timing.min_repetitions = atoi(argv[++i]);
+      continue;
+    } else if (strcmp(argv[i], "--max-repetitions") == 0 && i + 1 < argc) {
+      args->timing.max_repetitions = atoi(argv[++i]);
+      continue;
+    } else if (strcmp(argv[i], "--target-ci") == 0 && i + 1 < argc) {
+      args->timing.target_ci = atof(argv[++i]);
+      if (args->timing.target_ci < 0.0) {
+        benchmark_usage(argv[0]);
+      }
+      continue;
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      // process-wide, so it is applied here rather than kept in args
+      char *end;
+      const unsigned long long seed = strtoull(argv[++i], &end, 10);
+      if (*end != '\0' || end == argv[i]) {
+        benchmark_usage(argv[0]);
+      }
+      matrix_set_random_seed((uint64_t)seed);
+      continue;
+    } else if (strcmp(argv[i], "--counters") == 0) {
+      args->counters = 1;
+      continue;
+    } else if (strcmp(argv[i], "--reference-cache") == 0) {
+      target = &args->reference_cache;
+    } else if (strcmp(argv[i], "--a") == 0) {
+      target = &args->a_path;
+    } else if (strcmp(argv[i], "--b") == 0) {
+      target = &args->b_path;
+    } else if (strcmp(argv[i], "--c") == 0) {
+      target = &args->c_path;
+    } else if (argv[i][0] == '-' || args->output_folder != NULL) {
+      benchmark_usage(argv[0]);
+    } else {
+      args->output_folder = argv[i];
+      continue;
+    }
+    if (i + 1 >= argc) {
+      benchmark_usage(argv[0]);
+    }
+    *target = argv[++i];
   }
 
-  *matrix_size = atoi(argv[1]);
-  *thread_count = atoi(argv[2]);
-  *chunk_size = atoi(argv[3]);
+  // --repetitions alone also raises the maximum
+  if (args->timing.max_repetitions < args->timing.min_repetitions) {
+    args->timing.max_repetitions = args->timing.min_repetitions;
+  }
+  if (args->timing.min_repetitions < 1 ||
+      args->timing.max_repetitions > TIMING_MAX_SAMPLES) {
+    benchmark_usage(argv[0]);
+  }
+
+  if ((args->a_path == NULL) != (args->b_path == NULL) ||
+      (args->c_path != NULL && args->a_path == NULL) ||
+      (args->reference_cache != NULL && args->a_path != NULL)) {
+    benchmark_usage(argv[0]);
+  }
+}
+
+static void streaming_usage(char *program_name) {
+  printf("Usage: %s [--sizes N,N,...] [--budget-mb MB] [--directory DIR] "
+         "[--threads N] [--a FILE --b FILE] [--c FILE] [--seed N] "
+         "[output_folder]\n",
+         program_name);
+  printf("--sizes: matrix sizes, e.g. 50000,65536 (default "
+         "STREAMING_MATRIX_SIZES)\n");
+  printf("--budget-mb: memory mapped at once by the multiply (default %d)\n",
+         STREAMING_MEMORY_BUDGET_MB);
+  printf("--directory: scratch directory of the generated A, B and C files, "
+         "3 * n^2 doubles (default %s)\n",
+         STREAMING_DIRECTORY);
+  printf("--threads: threads of the chunk products (default %d)\n",
+         THREAD_COUNT);
+  printf("--a/--b: multiply binary matrix files instead of generated ones\n");
+  printf("--c: keep the product in this binary matrix file\n");
+  printf("--seed: seed of the generated inputs and the sampled entries "
+         "(default SEED, the time)\n");
+  exit(1);
 }
+
+// a positive count, or 0 when text is not one
+static size_t parse_count(const char *text, char **end) {
+  if (*text < '0' || *text > '9') {
+    *end = (char *)text;
+    return 0;
+  }
+  return (size_t)strtoull(text, end, 10);
+}
+
+void get_streaming_args(int argc, char *argv[], StreamingArgs *args) {
+  const int sizes[] = STREAMING_MATRIX_SIZES;
+  args->output_folder = NULL;
+  args->size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+  for (int i = 0; i < args->size_count; i++) {
+    args->sizes[i] = (size_t)sizes[i];
+  }
+  args->budget_mb = STREAMING_MEMORY_BUDGET_MB;
+  args->directory = STREAMING_DIRECTORY;
+  args->thread_count = THREAD_COUNT;
+  args->a_path = NULL;
+  args->b_path = NULL;
+  args->c_path = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    const char **target = NULL;
+    char *end;
+    if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+      const char *token = argv[++i];
+      args->size_count = 0;
+      do {
+        const size_t size = parse_count(token, &end);
+        if (size == 0 || args->size_count == STREAMING_MAX_SIZES ||
+            (*end != ',' && *end != '\0')) {
+          streaming_usage(argv[0]);
+        }
+        args->sizes[args->size_count++] = size;
+        token = end + 1;
+      } while (*end == ',');
+      continue;
+    } else if (strcmp(argv[i], "--budget-mb") == 0 && i + 1 < argc) {
+      args->budget_mb = parse_count(argv[++i], &end);
+      if (args->budget_mb == 0 || *end != '\0') {
+        streaming_usage(argv[0]);
+      }
+      continue;
+    } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      args->thread_count = (int)parse_count(argv[++i], &end);
+      if (args->thread_count < 1 || *end != '\0') {
+        streaming_usage(argv[0]);
+      }
+      continue;
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      const unsigned long long seed = strtoull(argv[++i], &end, 10);
+      if (*end != '\0' || end == argv[i]) {
+        streaming_usage(argv[0]);
+      }
+      matrix_set_random_seed((uint64_t)seed);
+      continue;
+    } else if (strcmp(argv[i], "--directory") == 0) {
+      target = &args->directory;
+    } else if (strcmp(argv[i], "--a") == 0) {
+      target = &args->a_path;
+    } else if (strcmp(argv[i], "--b") == 0) {
+      target = &args->b_path;
+    } else if (strcmp(argv[i], "--c") == 0) {
+      target = &args->c_path;
+    } else if (argv[i][0] == '-' || args->output_folder != NULL) {
+      streaming_usage(argv[0]);
+    } else {
+      args->output_folder = argv[i];
+      continue;
+    }
+    if (i + 1 >= argc) {
+      streaming_usage(argv[0]);
+    }
+    *target = argv[++i];
+  }
+
+  if ((args->a_path == NULL) != (args->b_path == NULL)) {
+    streaming_usage(argv[0]);
+  }
+}
+
+void benchmark_inputs(const BenchmarkArgs *args, int matrix_size, Matrix *a,
+                      Matrix *b) {
+  if (args->a_path != NULL) {
+    matrix_load(a, args->a_path);
+    matrix_load(b, args->b_path);
+    if (a->size != b->size) {
+      printf("Error: %s and %s hold matrices of different sizes\n",
+             args->a_path, args->b_path);
+      exit(1);
+    }
+    return;
+  }
+
+  // one input pair per (seed, size), whatever ran before, so that reference
+  // products can be cached under that key
+  const uint64_t key =
+      matrix_random_bits(~matrix_random_seed(), (uint64_t)matrix_size);
+  matrix_create(a, matrix_size);
+  matrix_create(b, matrix_size);
+  matrix_fill_random_key(a, matrix_random_bits(key, 0));
+  matrix_fill_random_key(b, matrix_random_bits(key, 1));
+}
+
+void benchmark_write_product(const BenchmarkArgs *args, int thread_count) {
+  if (args->c_path == NULL) {
+    return;
+  }
+
+  Matrix a, b, c;
+  benchmark_inputs(args, 0, &a, &b);
+  matrix_create(&c, a.size);
+  dgemm(GEMM_NO_TRANS, GEMM_NO_TRANS, a.size, a.size, a.size, 1.0, a.data,
+        a.ld, b.data, b.ld, 0.0, c.data, c.ld, NULL, thread_count);
+  matrix_store(&c, args->c_path);
+
+  matrix_destroy(&a);
+  matrix_destroy(&b);
+  matrix_destroy(&c);
+}
+
@@ -4,6 +4,7 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include "../benchmark/timing.h"
 #include "../matrix/matrix.h"
 
 typedef struct {
@@ -16,12 +17,78 @@ extern CSV_DATA csv_parallel_permutations;
 extern CSV_DATA csv_serial_parallel_scaling_classic;
 extern CSV_DATA csv_serial_parallel_scaling_improved;
 extern CSV_DATA csv_tiled;
+extern CSV_DATA csv_sparse;
+extern CSV_DATA csv_batched;
+extern CSV_DATA csv_streaming;
+extern CSV_DATA csv_kernel_metrics;
+extern CSV_DATA csv_roofline;
+extern CSV_DATA csv_sweep;
+extern CSV_DATA csv_scaling_suite;
+
+// command line of the benchmark executables:
+//   [--a FILE --b FILE [--c FILE]] [--validate reference|freivalds]
+//   [--trials N] [--reference-cache DIR] [--counters] [--warmup N]
+//   [--repetitions N] [--max-repetitions N] [--target-ci X] [--seed N]
+//   [output_folder]
+// with --a/--b the inputs are read from binary matrix files instead of being
+// generated, and with --c the product A * B is written to a matrix file.
+// --validate freivalds checks every product with N (default FREIVALDS_TRIALS)
+// Freivalds trials instead of comparing it with the baseline product, and
+// --reference-cache keeps the serial baselines on disk (see ReferenceCache).
+// --counters adds the hardware counters of every kernel run to
+// kernel_metrics.csv. --warmup/--repetitions/--max-repetitions/--target-ci
+// override the timing policy (WARMUP_RUNS, REPETITIONS, MAX_REPETITIONS,
+// TARGET_CI). --seed replaces SEED for the generated inputs; the reference
+// cache only hits across runs with the same seed
+typedef struct {
+  const char *output_folder;
+  const char *a_path;
+  const char *b_path;
+  const char *c_path;
+  const char *reference_cache;
+  int counters;
+  ValidationMode validation;
+  int freivalds_trials;
+  TimingPolicy timing;
+} BenchmarkArgs;
 
 FILE *open_csv_file(CSV_DATA);
 void clear_csv_file(CSV_DATA);
-void usage(char *);
-void get_args(int argc, char *argv[], int *matrix_size, int *thread_count,
-              int *chunk_size);
+void get_benchmark_args(int argc, char *argv[], BenchmarkArgs *args);
+// the input matrices named in args, or two random matrix_size matrices when
+// args has no input files
+void benchmark_inputs(const BenchmarkArgs *args, int matrix_size, Matrix *a,
+                      Matrix *b);
+// computes A * B with the packed GEMM engine and stores it to args->c_path;
+// does nothing when args has no output file
+void benchmark_write_product(const BenchmarkArgs *args, int thread_count);
+
+// longest --sizes list of the streaming executable
+#define STREAMING_MAX_SIZES 64
+
+// command line of the streaming executable:
+//   [--sizes N,N,...] [--budget-mb MB] [--directory DIR] [--threads N]
+//   [--a FILE --b FILE] [--c FILE] [--seed N] [output_folder]
+// --sizes lists the matrix sizes, --budget-mb the memory the multiply may map
+// at once and --directory the scratch directory of the generated A, B and C
+// files, which must have room for 3 * n^2 doubles. --a/--b multiply binary
+// matrix files instead (one run, at the size stored in the files), --c keeps
+// the product in a file instead of the scratch one. Defaults come from
+// parameters.h: STREAMING_MATRIX_SIZES, STREAMING_MEMORY_BUDGET_MB,
+// STREAMING_DIRECTORY and THREAD_COUNT
+typedef struct {
+  const char *output_folder;
+  size_t sizes[STREAMING_MAX_SIZES];
+  int size_count;
+  size_t budget_mb;
+  const char *directory;
+  int thread_count;
+  const char *a_path;
+  const char *b_path;
+  const char *c_path;
+} StreamingArgs;
+
+void get_streaming_args(int argc, char *argv[], StreamingArgs *args);
 void set_output_folder(const char *folder_name);
 void ensure_directory_exists(const char *path);
 
@@ -28,6 +28,13 @@ def main():
         "plot_serial_parallel_scaling_classic.py",
         "plot_serial_parallel_scaling_improved.py",
         "plot_tiled.py",
+        "plot_sparse.py",
+        "plot_batched.py",
+        "plot_streaming.py",
+        "plot_kernel_metrics.py",
+        "plot_roofline.py",
+        "plot_sweep.py",
+        "plot_scaling_suite.py",
     ]
 
     print("Generating plots...")
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+
+import matplotlib.pyplot as plt
+import seaborn as sns
+from pathlib import Path
+import sys
+
+from utils import load_csv, get_directories, setup_plot_style
+
+
+def plot_batched(folder_name: str = None, save: bool = True, show: bool = False) -> bool:
+    setup_plot_style()
+    data_dir, plots_dir = get_directories(Path(__file__), folder_name)
+
+    df = load_csv(data_dir, "batched.csv")
+    if df is None:
+        print("Skipping batched plot - data file not available")
+        return False
+
+    imp_cols = [
+        "PARALLEL_IKJ_LOOP",
+        "BATCHED",
+        "BATCHED_STRIDED",
+        "ADAPTIVE_IKJ_LOOP",
+    ]
+    # Filter only existing columns
+    imp_cols = [c for c in imp_cols if c in df.columns]
+
+    # Melt dataframe
+    melted_df = df.melt(
+        id_vars=["MATRIX_SIZE"],
+        value_vars=imp_cols,
+        var_name="Implementation",
+        value_name="Speedup",
+    )
+
+    # Rename implementations for better legend labels
+    rename_map = {
+        "PARALLEL_IKJ_LOOP": "Loop over Parallel IKJ",
+        "BATCHED": "Batched (pointer array)",
+        "BATCHED_STRIDED": "Batched (strided)",
+        "ADAPTIVE_IKJ_LOOP": "Loop over Adaptive IKJ",
+    }
+    melted_df["Implementation"] = melted_df["Implementation"].replace(rename_map)
+
+    ax = sns.barplot(
+        data=melted_df,
+        x="MATRIX_SIZE",
+        y="Speedup",
+        hue="Implementation",
+        errorbar="sd",
+    )
+    ax.set_yscale("log")
+
+    ax.set_xlabel("Matrix Size (N)", fontsize=14, fontweight="bold")
+    ax.set_ylabel("Speedup (log scale)", fontsize=14, fontweight="bold")
+    ax.set_title(
+        "Batched Small-Matrix Multiplication: Speedup vs Per-Item Parallel Loop",
+        fontsize=16,
+        fontweight="bold",
+        pad=20,
+    )
+    sns.move_legend(
+        ax, "upper left", bbox_to_anchor=(1.02, 1), borderaxespad=0, title="Legend"
+    )
+
+    # Use figure object for layout and saving
+    fig = ax.get_figure()
+    fig.tight_layout()
+
+    if save:
+        output_path = plots_dir / "batched.png"
+        fig.savefig(output_path, dpi=300, bbox_inches="tight")
+        print(f"Plot saved to {output_path}")
+
+    if show:
+        plt.show()
+    else:
+        plt.close()
+
+    return True
+
+
+def main():
+    folder_name = sys.argv[1] if len(sys.argv) > 1 else None
+    print("Creating batched plot...")
+    try:
+        plot_batched(folder_name)
+        print("Plot generation complete!")
+    except Exception as e:
+        print(f"Error creating batched plot: {e}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
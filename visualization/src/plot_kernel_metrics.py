@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+
+import matplotlib.pyplot as plt
+import seaborn as sns
+from pathlib import Path
+import sys
+
+from utils import load_csv, get_directories, setup_plot_style
+
+
+def plot_kernel_metrics(
+    folder_name: str = None, save: bool = True, show: bool = False
+) -> bool:
+    setup_plot_style()
+    data_dir, plots_dir = get_directories(Path(__file__), folder_name)
+
+    df = load_csv(data_dir, "kernel_metrics.csv")
+    if df is None:
+        print("Skipping kernel metrics plot - data file not available")
+        return False
+
+    # rows without counters (perf_event_open unavailable) carry only times
+    df = df.dropna(subset=["CYCLES", "INSTRUCTIONS"])
+    if df.empty:
+        print("Skipping kernel metrics plot - no hardware counters recorded")
+        return False
+
+    # the largest matrix size of every benchmark, averaged over repeated rows
+    # (chunk/block sizes)
+    largest = df.groupby("BENCHMARK")["MATRIX_SIZE"].transform("max")
+    df = df[df["MATRIX_SIZE"] == largest].copy()
+
+    df["IPC"] = df["INSTRUCTIONS"] / df["CYCLES"]
+    # Filter only existing columns
+    miss_cols = [
+        c for c in ["L1D_MISSES", "LLC_MISSES", "DTLB_MISSES"] if c in df.columns
+    ]
+    metrics = ["IPC"]
+    for col in miss_cols:
+        df[col + "_PKI"] = df[col] / df["INSTRUCTIONS"] * 1000.0
+        metrics.append(col + "_PKI")
+
+    # Rename metrics for better axis labels
+    rename_map = {
+        "IPC": "Instructions per Cycle",
+        "L1D_MISSES_PKI": "L1D Misses / 1k Instructions",
+        "LLC_MISSES_PKI": "LLC Misses / 1k Instructions",
+        "DTLB_MISSES_PKI": "dTLB Misses / 1k Instructions",
+    }
+
+    fig, axes = plt.subplots(
+        len(metrics), 1, figsize=(14, 4.5 * len(metrics)), squeeze=False
+    )
+    for ax, metric in zip(axes[:, 0], metrics):
+        sns.barplot(
+            data=df,
+            x="KERNEL",
+            y=metric,
+            hue="BENCHMARK",
+            errorbar=None,
+            ax=ax,
+        )
+        ax.set_xlabel("")
+        ax.set_ylabel(rename_map[metric], fontsize=12, fontweight="bold")
+        ax.tick_params(axis="x", rotation=45)
+        for label in ax.get_xticklabels():
+            label.set_horizontalalignment("right")
+        sns.move_legend(
+            ax, "upper left", bbox_to_anchor=(1.02, 1), borderaxespad=0, title="Benchmark"
+        )
+
+    axes[0, 0].set_title(
+        "Hardware Counters per Kernel (largest matrix size)",
+        fontsize=16,
+        fontweight="bold",
+        pad=20,
+    )
+    fig.tight_layout()
+
+    if save:
+        output_path = plots_dir / "kernel_metrics.png"
+        fig.savefig(output_path, dpi=300, bbox_inches="tight")
+        print(f"Plot saved to {output_path}")
+
+    if show:
+        plt.show()
+    else:
+        plt.close()
+
+    return True
+
+
+def main():
+    folder_name = sys.argv[1] if len(sys.argv) > 1 else None
+    print("Creating kernel metrics plot...")
+    try:
+        plot_kernel_metrics(folder_name)
+        print("Plot generation complete!")
+    except Exception as e:
+        print(f"Error creating kernel metrics plot: {e}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+
+import matplotlib.pyplot as plt
+import numpy as np
+import seaborn as sns
+from pathlib import Path
+import sys
+
+from utils import load_csv, get_directories, setup_plot_style
+
+
+def plot_roofline(
+    folder_name: str = None, save: bool = True, show: bool = False
+) -> bool:
+    setup_plot_style()
+    data_dir, plots_dir = get_directories(Path(__file__), folder_name)
+
+    ceilings = load_csv(data_dir, "roofline.csv")
+    df = load_csv(data_dir, "kernel_metrics.csv")
+    if ceilings is None or df is None:
+        print("Skipping roofline plot - data file not available")
+        return False
+
+    # rows written before the roofline columns existed carry no GFLOPS
+    if "GFLOPS" not in df.columns:
+        print("Skipping roofline plot - no roofline data recorded")
+        return False
+    df = df.dropna(subset=["GFLOPS", "INTENSITY"])
+
+    # the probes of every run, median per team size
+    ceilings = ceilings.groupby("THREADS")[["PEAK_GFLOPS", "BANDWIDTH_GBS"]].median()
+    df = df[df["THREADS"].isin(ceilings.index)]
+    if df.empty:
+        print("Skipping roofline plot - no kernel rows with a probed roofline")
+        return False
+
+    # the largest matrix size of every benchmark, averaged over repeated rows
+    # (chunk/block sizes and runs)
+    largest = df.groupby("BENCHMARK")["MATRIX_SIZE"].transform("max")
+    df = df[df["MATRIX_SIZE"] == largest]
+    df = (
+        df.groupby(["THREADS", "BENCHMARK", "KERNEL"], as_index=False)
+        .agg(
+            {
+                "GFLOPS": "mean",
+                "INTENSITY": "mean",
+                "MEASURED_INTENSITY": "mean",
+                "ROOFLINE_PERCENT": "mean",
+            }
+        )
+    )
+    df["LABEL"] = df["BENCHMARK"] + " / " + df["KERNEL"]
+
+    thread_counts = sorted(df["THREADS"].unique())
+    columns = min(2, len(thread_counts))
+    rows = (len(thread_counts) + columns - 1) // columns
+    fig, axes = plt.subplots(
+        rows, columns, figsize=(11 * columns, 8 * rows), squeeze=False
+    )
+
+    palette = dict(
+        zip(sorted(df["LABEL"].unique()), sns.color_palette("husl", df["LABEL"].nunique()))
+    )
+    for ax, threads in zip(axes.flat, thread_counts):
+        peak = ceilings.loc[threads, "PEAK_GFLOPS"]
+        bandwidth = ceilings.loc[threads, "BANDWIDTH_GBS"]
+        subset = df[df["THREADS"] == threads]
+
+        intensities = subset["INTENSITY"].tolist() + subset["MEASURED_INTENSITY"].dropna().tolist()
+        ridge = peak / bandwidth
+        x = np.logspace(
+            np.log10(min(intensities + [ridge]) / 4), np.log10(max(intensities + [ridge]) * 4), 200
+        )
+        ax.plot(x, np.minimum(peak, x * bandwidth), color="black", linewidth=2.5)
+        ax.axvline(ridge, color="gray", linestyle=":", linewidth=1.5)
+        ax.annotate(
+            f"{peak:.1f} GFLOP/s, {bandwidth:.1f} GB/s",
+            xy=(ridge, peak),
+            xytext=(8, 8),
+            textcoords="offset points",
+            fontsize=11,
+        )
+
+        # filled: compulsory traffic intensity, hollow: from the LLC misses
+        for _, row in subset.iterrows():
+            color = palette[row["LABEL"]]
+            ax.scatter(row["INTENSITY"], row["GFLOPS"], color=color, s=80, label=row["LABEL"])
+            if not np.isnan(row["MEASURED_INTENSITY"]):
+                ax.scatter(
+                    row["MEASURED_INTENSITY"],
+                    row["GFLOPS"],
+                    facecolors="none",
+                    edgecolors=color,
+                    s=80,
+                )
+
+        ax.set_xscale("log")
+        ax.set_yscale("log")
+        ax.set_xlabel("Arithmetic Intensity (flop/byte)", fontsize=12, fontweight="bold")
+        ax.set_ylabel("GFLOP/s", fontsize=12, fontweight="bold")
+        ax.set_title(f"{threads} thread(s)", fontsize=14, fontweight="bold")
+        ax.legend(loc="upper left", bbox_to_anchor=(1.02, 1), borderaxespad=0, fontsize=9)
+
+    for ax in axes.flat[len(thread_counts):]:
+        ax.set_visible(False)
+
+    fig.suptitle(
+        "Roofline per Team Size (largest matrix size)",
+        fontsize=16,
+        fontweight="bold",
+    )
+    fig.tight_layout()
+
+    if save:
+        output_path = plots_dir / "roofline.png"
+        fig.savefig(output_path, dpi=300, bbox_inches="tight")
+        print(f"Plot saved to {output_path}")
+
+    if show:
+        plt.show()
+    else:
+        plt.close()
+
+    return True
+
+
+def main():
+    folder_name = sys.argv[1] if len(sys.argv) > 1 else None
+    print("Creating roofline plot...")
+    try:
+        plot_roofline(folder_name)
+        print("Plot generation complete!")
+    except Exception as e:
+        print(f"Error creating roofline plot: {e}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
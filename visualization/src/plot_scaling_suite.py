@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+
+import matplotlib.pyplot as plt
+import seaborn as sns
+from pathlib import Path
+import sys
+
+from utils import load_csv, get_directories, setup_plot_style
+
+
+def plot_scaling_suite(
+    folder_name: str = None, save: bool = True, show: bool = False
+) -> bool:
+    setup_plot_style()
+    data_dir, plots_dir = get_directories(Path(__file__), folder_name)
+
+    df = load_csv(data_dir, "scaling_suite.csv")
+    if df is None:
+        print("Skipping scaling suite plot - data file not available")
+        return False
+
+    # the largest base size of every mode, averaged over repeated rows
+    largest = df.groupby("MODE")["BASE_SIZE"].transform("max")
+    df = df[df["BASE_SIZE"] == largest]
+    df = df.groupby(
+        ["MODE", "KERNEL", "THREADS", "PARAMETER"], as_index=False
+    )[["TIME", "EFFICIENCY", "KARP_FLATT", "PHYSICAL_CORES"]].mean()
+
+    # each kernel with the chunk/block size that is fastest on the most threads
+    most_threads = df.groupby(["MODE", "KERNEL"])["THREADS"].transform("max")
+    widest = df[df["THREADS"] == most_threads]
+    best = widest.loc[widest.groupby(["MODE", "KERNEL"])["TIME"].idxmin()]
+    df = df.merge(
+        best[["MODE", "KERNEL", "PARAMETER"]], on=["MODE", "KERNEL", "PARAMETER"]
+    )
+
+    modes = [mode for mode in ("STRONG", "WEAK") if mode in set(df["MODE"])]
+    if not modes:
+        print("Skipping scaling suite plot - no scaling rows recorded")
+        return False
+    physical_cores = df["PHYSICAL_CORES"].max()
+
+    fig, axes = plt.subplots(
+        len(modes), 2, figsize=(20, 7 * len(modes)), squeeze=False
+    )
+    for row, mode in zip(axes, modes):
+        data = df[df["MODE"] == mode]
+        for ax, metric, label in (
+            (row[0], "EFFICIENCY", "Parallel Efficiency"),
+            (row[1], "KARP_FLATT", "Karp-Flatt Serial Fraction"),
+        ):
+            sns.lineplot(
+                data=data.dropna(subset=[metric]),
+                x="THREADS",
+                y=metric,
+                hue="KERNEL",
+                marker="o",
+                dashes=False,
+                linewidth=2,
+                markersize=7,
+                alpha=0.8,
+                ax=ax,
+            )
+            # past the physical cores the extra threads run on SMT siblings
+            ax.axvline(physical_cores, color="gray", linestyle="--", linewidth=1.5)
+            ax.axvspan(
+                physical_cores,
+                max(data["THREADS"].max(), physical_cores),
+                color="gray",
+                alpha=0.1,
+            )
+            ax.set_xlabel("Threads", fontsize=14, fontweight="bold")
+            ax.set_ylabel(label, fontsize=14, fontweight="bold")
+            ax.set_title(
+                f"{mode.capitalize()} scaling: {label}", fontsize=14, fontweight="bold"
+            )
+            ax.legend(title="Kernel", fontsize=9)
+
+    fig.suptitle(
+        f"Scaling Suite ({physical_cores} physical cores, SMT siblings shaded)",
+        fontsize=16,
+        fontweight="bold",
+    )
+    fig.tight_layout()
+
+    if save:
+        output_path = plots_dir / "scaling_suite.png"
+        fig.savefig(output_path, dpi=300, bbox_inches="tight")
+        print(f"Plot saved to {output_path}")
+
+    if show:
+        plt.show()
+    else:
+        plt.close()
+
+    return True
+
+
+def main():
+    folder_name = sys.argv[1] if len(sys.argv) > 1 else None
+    print("Creating scaling suite plot...")
+    try:
+        plot_scaling_suite(folder_name)
+        print("Plot generation complete!")
+    except Exception as e:
+        print(f"Error creating scaling suite plot: {e}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
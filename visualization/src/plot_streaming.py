@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+
+import matplotlib.pyplot as plt
+import seaborn as sns
+from pathlib import Path
+import sys
+
+from utils import load_csv, get_directories, setup_plot_style
+
+
+def plot_streaming(folder_name: str = None, save: bool = True, show: bool = False) -> bool:
+    setup_plot_style()
+    data_dir, plots_dir = get_directories(Path(__file__), folder_name)
+
+    df = load_csv(data_dir, "streaming.csv")
+    if df is None:
+        print("Skipping streaming plot - data file not available")
+        return False
+
+    ax = sns.lineplot(
+        data=df,
+        x="MATRIX_SIZE",
+        y="GFLOPS",
+        hue="MEMORY_BUDGET_MB",
+        style="THREADS",
+        markers=True,
+        dashes=False,
+        errorbar="sd",
+        linewidth=2,
+        markersize=7,
+        alpha=0.8,
+    )
+
+    ax.set_xlabel("Matrix Size (N)", fontsize=14, fontweight="bold")
+    ax.set_ylabel("GFLOP/s", fontsize=14, fontweight="bold")
+    ax.set_title(
+        "Out-of-Core Streaming Multiplication: GFLOP/s vs Matrix Size by Memory Budget",
+        fontsize=16,
+        fontweight="bold",
+        pad=20,
+    )
+    sns.move_legend(
+        ax, "upper left", bbox_to_anchor=(1.02, 1), borderaxespad=0, title="Budget (MiB)"
+    )
+
+    # Use figure object for layout and saving
+    fig = ax.get_figure()
+    fig.tight_layout()
+
+    if save:
+        output_path = plots_dir / "streaming.png"
+        fig.savefig(output_path, dpi=300, bbox_inches="tight")
+        print(f"Plot saved to {output_path}")
+
+    if show:
+        plt.show()
+    else:
+        plt.close()
+
+    return True
+
+
+def main():
+    folder_name = sys.argv[1] if len(sys.argv) > 1 else None
+    print("Creating streaming plot...")
+    try:
+        plot_streaming(folder_name)
+        print("Plot generation complete!")
+    except Exception as e:
+        print(f"Error creating streaming plot: {e}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
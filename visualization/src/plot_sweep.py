@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+import matplotlib.pyplot as plt
+import seaborn as sns
+from pathlib import Path
+import sys
+
+from utils import load_csv, get_directories, setup_plot_style
+
+
+def plot_sweep(folder_name: str = None, save: bool = True, show: bool = False) -> bool:
+    setup_plot_style()
+    data_dir, plots_dir = get_directories(Path(__file__), folder_name)
+
+    df = load_csv(data_dir, "sweep.csv")
+    if df is None:
+        print("Skipping sweep plot - data file not available")
+        return False
+
+    # square products only, each kernel with its best chunk/block size
+    df = df[(df["M"] == df["N"]) & (df["N"] == df["K"])]
+    if df.empty:
+        print("Skipping sweep plot - no square products recorded")
+        return False
+    df = df.groupby(["KERNEL", "M", "THREADS", "PARAMETER"], as_index=False)["GFLOPS"].mean()
+    df = df.groupby(["KERNEL", "M", "THREADS"], as_index=False)["GFLOPS"].max()
+
+    thread_counts = sorted(df["THREADS"].unique())
+    fig, axes = plt.subplots(
+        len(thread_counts), 1, figsize=(14, 6 * len(thread_counts)), squeeze=False
+    )
+    for ax, threads in zip(axes[:, 0], thread_counts):
+        sns.lineplot(
+            data=df[df["THREADS"] == threads],
+            x="M",
+            y="GFLOPS",
+            hue="KERNEL",
+            marker="o",
+            dashes=False,
+            linewidth=2,
+            markersize=7,
+            alpha=0.8,
+            ax=ax,
+        )
+        ax.set_xlabel("Matrix Size (N)", fontsize=14, fontweight="bold")
+        ax.set_ylabel("GFLOP/s", fontsize=14, fontweight="bold")
+        ax.set_title(f"{threads} thread(s)", fontsize=14, fontweight="bold")
+        sns.move_legend(
+            ax, "upper left", bbox_to_anchor=(1.02, 1), borderaxespad=0, title="Kernel"
+        )
+
+    fig.suptitle(
+        "Sweep: GFLOP/s vs Matrix Size (best chunk/block size per kernel)",
+        fontsize=16,
+        fontweight="bold",
+    )
+    fig.tight_layout()
+
+    if save:
+        output_path = plots_dir / "sweep.png"
+        fig.savefig(output_path, dpi=300, bbox_inches="tight")
+        print(f"Plot saved to {output_path}")
+
+    if show:
+        plt.show()
+    else:
+        plt.close()
+
+    return True
+
+
+def main():
+    folder_name = sys.argv[1] if len(sys.argv) > 1 else None
+    print("Creating sweep plot...")
+    try:
+        plot_sweep(folder_name)
+        print("Plot generation complete!")
+    except Exception as e:
+        print(f"Error creating sweep plot: {e}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -23,6 +23,14 @@ def plot_tiled(folder_name: str = None, save: bool = True, show: bool = False) -
         "SERIAL_TILED",
         "PARALLEL_TILED",
         "PARALLEL_TILED_TASKS",
+        "SERIAL_TILED_PACKED",
+        "PARALLEL_TILED_PACKED",
+        "PARALLEL_TILED_KSPLIT",
+        "STRASSEN",
+        "PARALLEL_RECURSIVE",
+        "PARALLEL_TILED_MORTON",
+        "PARALLEL_RECURSIVE_MORTON",
+        "ADAPTIVE_TILED",
     ]
     # Filter only existing columns
     imp_cols = [c for c in imp_cols if c in df.columns]
@@ -42,6 +50,14 @@ def plot_tiled(folder_name: str = None, save: bool = True, show: bool = False) -
         "SERIAL_TILED": "Serial Tiled",
         "PARALLEL_TILED": "Parallel Tiled",
         "PARALLEL_TILED_TASKS": "Parallel Tiled Tasks",
+        "SERIAL_TILED_PACKED": "Serial Tiled Packed",
+        "PARALLEL_TILED_PACKED": "Parallel Tiled Packed",
+        "PARALLEL_TILED_KSPLIT": "Parallel Tiled K-Split",
+        "STRASSEN": "Strassen-Winograd",
+        "PARALLEL_RECURSIVE": "Parallel Recursive",
+        "PARALLEL_TILED_MORTON": "Parallel Tiled Z-Order",
+        "PARALLEL_RECURSIVE_MORTON": "Parallel Recursive Z-Order",
+        "ADAPTIVE_TILED": "Adaptive Tiled",
     }
     melted_df["Implementation"] = melted_df["Implementation"].replace(rename_map)
 